@@ -32,6 +32,8 @@
 
 #include "remote.h"
 #include "gui.h"
+#include "remote_log.h"
+#include "coap_client.h"
 
 
 #include "sl_component_catalog.h"
@@ -44,6 +46,7 @@
 #endif
 
 #include "printf.h"
+#include "sl_sleeptimer.h"
 
 #if OPENTHREAD_CONFIG_HEAP_EXTERNAL_ENABLE
 void *otPlatCAlloc(size_t aNum, size_t aSize)
@@ -59,6 +62,8 @@ void otPlatFree(void *aPtr)
 
 static otInstance *    sInstance       = NULL;
 
+static sl_sleeptimer_timer_handle_t gui_frame_timer;
+
 otInstance *otGetInstance(void)
 {
     return sInstance;
@@ -84,7 +89,8 @@ void otPlatLog(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat
     va_list ap;
     va_start(ap, aFormat);
 //    otCliPlatLogv(aLogLevel, aLogRegion, aFormat, ap);
-    printf(aFormat, ap);
+    vprintf(aFormat, ap);
+    printf("\r\n");
     va_end(ap);
 }
 #endif
@@ -95,12 +101,28 @@ void sl_ot_create_instance(void)
     assert(sInstance);
 }
 
+// runs from the sleeptimer interrupt
+static void gui_frame_timer_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+    (void) handle;
+    (void) data;
+
+    gui_frame_tick();
+}
+
 /**************************************************************************//**
  * Application Init.
  *****************************************************************************/
 void app_init(void)
 {
-  gui_init();
+  sl_status_t status;
+
+  // the remote still clicks without a display
+  status = gui_init();
+  if(status != SL_STATUS_OK)
+  {
+      REMOTE_LOG_ERROR(REMOTE_LOG_GUI_INIT, status);
+  }
   remote_init(otGetInstance());
 }
 
@@ -111,8 +133,27 @@ void app_process_action(void)
 {
     otTaskletsProcess(sInstance);
     otSysProcessDrivers(sInstance);
-    gui_update();
+    remote_process();
+    coap_client_process(sInstance);
+    if(gui_update())
+    {
+        sl_sleeptimer_restart_timer_ms(&gui_frame_timer, GUI_FRAME_INTERVAL_MS,
+                                       gui_frame_timer_callback, NULL, 0, 0);
+    }
+    remote_log_process();
+}
+
+#ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+/**************************************************************************//**
+ * Power Manager hook, called before the main loop goes to sleep.
+ * The display flush and the log output are spread over several passes, keep
+ * the loop running until they are done instead of waiting for an interrupt.
+ *****************************************************************************/
+bool app_is_ok_to_sleep(void)
+{
+    return !gui_is_busy() && !remote_log_is_pending();
 }
+#endif
 
 /**************************************************************************//**
  * Application Exit.
@@ -0,0 +1,93 @@
+/***************************************************************************//**
+ * @file
+ * @brief Base Station Selection
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include "base_station_select.h"
+
+void base_station_select_init(base_station_select_t* select, uint16_t failed_rloc16)
+{
+  select->failed_rloc16 = failed_rloc16;
+  select->best_rloc16   = BASE_STATION_RLOC16_INVALID;
+  select->best_cost     = UINT16_MAX;
+}
+
+uint8_t base_station_path_cost(uint16_t own_rloc16, uint16_t rloc16, uint8_t router_cost)
+{
+  if(rloc16 == own_rloc16)
+  {
+      return 0;
+  }
+
+  if(router_cost >= BASE_STATION_PATH_COST_UNKNOWN)
+  {
+      return BASE_STATION_PATH_COST_UNKNOWN;
+  }
+
+  // the low 9 bits are the child id, 0 for the router itself
+  if(rloc16 & 0x01ff)
+  {
+      router_cost++;
+  }
+
+  return router_cost;
+}
+
+void base_station_select_offer(base_station_select_t* select, uint16_t rloc16, uint8_t path_cost)
+{
+  uint16_t cost = path_cost;
+
+  // ranks behind every other server, whatever its path cost
+  if(rloc16 == select->failed_rloc16)
+  {
+      cost += UINT8_MAX;
+  }
+
+  if(cost < select->best_cost)
+  {
+      select->best_cost   = cost;
+      select->best_rloc16 = rloc16;
+  }
+}
+
+bool base_station_select_result(const base_station_select_t* select, uint16_t* rloc16)
+{
+  if(select->best_cost == UINT16_MAX)
+  {
+      return false;
+  }
+
+  *rloc16 = select->best_rloc16;
+
+  return true;
+}
@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ * @file
+ * @brief Base Station Selection Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef BASE_STATION_SELECT_H_
+#define BASE_STATION_SELECT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BASE_STATION_RLOC16_INVALID       0xfffe
+
+// path cost of a server the router table has no route to
+#define BASE_STATION_PATH_COST_UNKNOWN    0xfe
+
+// Ranks the base station servers of the network data as they are iterated.
+// the lowest path cost wins, the server that let a request time out ranks
+// behind every other one whatever its cost and is only picked when it is the
+// only one left. ties go to the server offered first
+typedef struct {
+  uint16_t  failed_rloc16;    // BASE_STATION_RLOC16_INVALID when none failed
+  uint16_t  best_rloc16;
+  uint16_t  best_cost;        // UINT16_MAX until a server was offered
+} base_station_select_t;
+
+void  base_station_select_init(base_station_select_t* select, uint16_t failed_rloc16);
+
+// path cost from this device to rloc16, given the cost to its router.
+// router_cost is BASE_STATION_PATH_COST_UNKNOWN when there is no route, a
+// child is one hop behind its parent router. 0 when rloc16 is own_rloc16
+uint8_t base_station_path_cost(uint16_t own_rloc16, uint16_t rloc16, uint8_t router_cost);
+
+// a server of the base station service with its path cost
+void  base_station_select_offer(base_station_select_t* select, uint16_t rloc16, uint8_t path_cost);
+
+// the best server offered, false when none was
+bool  base_station_select_result(const base_station_select_t* select, uint16_t* rloc16);
+
+#endif /* BASE_STATION_SELECT_H_ */
@@ -0,0 +1,172 @@
+/***************************************************************************//**
+ * @file
+ * @brief Stand-in Base Station CoAP Server
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include "base_station_stub.h"
+
+#if BASE_STATION_STUB_ENABLE
+
+#include <openthread/coap.h>
+
+#include <string.h>
+
+#include "click_dedup.h"
+#include "coap_client.h"
+#include "remote.h"
+#include "remote_log.h"
+
+static void stub_answer_handler(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo);
+static void stub_send_ack(otInstance *aInstance, const otMessageInfo *aMessageInfo, const click_window_t* window);
+
+static  otInstance*     stub_instance;
+static  click_window_t  windows[BASE_STATION_STUB_DEVICES];
+static  click_dedup_t   dedup;
+static  uint32_t        clicks;
+
+static  otCoapResource  answer_resource = {
+    .mUriPath   = "question/answer",
+    .mHandler   = stub_answer_handler,
+    .mContext   = NULL,
+    .mNext      = NULL,
+};
+
+void base_station_stub_init(otInstance *aInstance)
+{
+  stub_instance = aInstance;
+  click_dedup_init(&dedup, windows, BASE_STATION_STUB_DEVICES);
+  otCoapAddResource(aInstance, &answer_resource);
+}
+
+uint32_t base_station_stub_get_clicks(void)
+{
+  return clicks;
+}
+
+// cumulative ack, last seq without gaps followed by the bitmap after it
+static void stub_send_ack(otInstance *aInstance, const otMessageInfo *aMessageInfo, const click_window_t* window)
+{
+  otMessage*    message;
+  otMessageInfo ack_info;
+  uint8_t       ack[6];
+
+  message = otCoapNewMessage(aInstance, NULL);
+  if(message == NULL)
+  {
+      return;
+  }
+
+  otCoapMessageInit(message, OT_COAP_TYPE_NON_CONFIRMABLE, OT_COAP_CODE_POST);
+  otCoapMessageGenerateToken(message, OT_COAP_DEFAULT_TOKEN_LENGTH);
+
+  ack[0] = (uint8_t) (window->last >> 8);
+  ack[1] = (uint8_t) window->last;
+  ack[2] = (uint8_t) (window->seen >> 24);
+  ack[3] = (uint8_t) (window->seen >> 16);
+  ack[4] = (uint8_t) (window->seen >> 8);
+  ack[5] = (uint8_t) window->seen;
+
+  memset(&ack_info, 0, sizeof(ack_info));
+  ack_info.mPeerAddr = aMessageInfo->mPeerAddr;
+  ack_info.mPeerPort = OT_DEFAULT_COAP_PORT;
+
+  if((otCoapMessageAppendUriPathOptions(message, COAP_CLIENT_ACK_URI_PATH) != OT_ERROR_NONE) ||
+     (otCoapMessageSetPayloadMarker(message) != OT_ERROR_NONE) ||
+     (otMessageAppend(message, ack, sizeof(ack)) != OT_ERROR_NONE) ||
+     (otCoapSendRequestWithParameters(aInstance, message, &ack_info, NULL, NULL, NULL) != OT_ERROR_NONE))
+  {
+      otMessageFree(message);
+  }
+}
+
+static void stub_answer_handler(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo)
+{
+  uint8_t         click[CLICK_PAYLOAD_LEN];
+  uint16_t        seq;
+  uint16_t        epoch;
+  click_window_t* window;
+  otMessage*      response;
+
+  (void) aContext;
+
+  // only the binary click payload carries the sequence number
+  if((otMessageRead(aMessage, otMessageGetOffset(aMessage), click, sizeof(click)) != sizeof(click)) ||
+     (click[0] != CLICK_PAYLOAD_VERSION))
+  {
+      return;
+  }
+
+  seq     = (uint16_t) ((click[10] << 8) | click[11]);
+  epoch   = (uint16_t) ((click[16] << 8) | click[17]);
+  window  = click_dedup_lookup(&dedup, &click[1], epoch);
+
+  // no room for another remote, left unanswered so the remote gives up on
+  // the click instead of believing it was counted
+  if(window == NULL)
+  {
+      REMOTE_LOG_INFO(REMOTE_LOG_STUB_REFUSED, seq);
+      return;
+  }
+
+  if(click_dedup_accept(&dedup, window, seq))
+  {
+      clicks++;
+      REMOTE_LOG_INFO(REMOTE_LOG_STUB_CLICK, seq, click[9]);
+  }
+  else
+  {
+      REMOTE_LOG_INFO(REMOTE_LOG_STUB_DUPLICATE, seq);
+  }
+
+  if(otCoapMessageGetType(aMessage) == OT_COAP_TYPE_CONFIRMABLE)
+  {
+      // piggybacked ack, confirmable clicks need nothing else
+      response = otCoapNewMessage(stub_instance, NULL);
+      if(response == NULL)
+      {
+          return;
+      }
+
+      if((otCoapMessageInitResponse(response, aMessage, OT_COAP_TYPE_ACKNOWLEDGMENT, OT_COAP_CODE_CHANGED) != OT_ERROR_NONE) ||
+         (otCoapSendResponse(stub_instance, response, aMessageInfo) != OT_ERROR_NONE))
+      {
+          otMessageFree(response);
+      }
+  }
+  else
+  {
+      stub_send_ack(stub_instance, aMessageInfo, window);
+  }
+}
+
+#endif
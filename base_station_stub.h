@@ -0,0 +1,62 @@
+/***************************************************************************//**
+ * @file
+ * @brief Stand-in Base Station CoAP Server Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef BASE_STATION_STUB_H_
+#define BASE_STATION_STUB_H_
+
+#include <openthread/instance.h>
+
+// 1 builds a minimal base station into the remote, for testing clicks
+// against another remote without the real base station. it serves the
+// answer resource, counts each click of a device exactly once and acks
+// non-confirmable clicks on the sender's ack resource
+#ifndef BASE_STATION_STUB_ENABLE
+#define BASE_STATION_STUB_ENABLE      0
+#endif
+
+// click windows, one per remote of the deployment plus room for the reboots
+// seen while they click. clicks of remotes beyond that are refused
+#ifndef BASE_STATION_STUB_DEVICES
+#define BASE_STATION_STUB_DEVICES     32
+#endif
+
+#if BASE_STATION_STUB_ENABLE
+void      base_station_stub_init(otInstance *aInstance);
+
+// unique clicks counted since init
+uint32_t  base_station_stub_get_clicks(void);
+#endif
+
+#endif /* BASE_STATION_STUB_H_ */
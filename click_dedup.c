@@ -0,0 +1,152 @@
+/***************************************************************************//**
+ * @file
+ * @brief Click Deduplication
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include "click_dedup.h"
+
+#include <string.h>
+
+void click_dedup_init(click_dedup_t* dedup, click_window_t* windows, uint32_t count)
+{
+  dedup->windows  = windows;
+  dedup->count    = count;
+  dedup->stamp    = 0;
+
+  memset(windows, 0, count * sizeof(*windows));
+}
+
+click_window_t* click_dedup_lookup(click_dedup_t* dedup, const uint8_t* eui64, uint16_t epoch)
+{
+  click_window_t* window;
+  click_window_t* free_window   = NULL;
+  click_window_t* old_epoch     = NULL;
+
+  for(uint32_t i = 0; i < dedup->count; i++)
+  {
+      window = &dedup->windows[i];
+
+      if(!window->in_use)
+      {
+          if(free_window == NULL)
+          {
+              free_window = window;
+          }
+          continue;
+      }
+
+      if(memcmp(window->eui64, eui64, sizeof(window->eui64)) != 0)
+      {
+          continue;
+      }
+
+      if(window->epoch == epoch)
+      {
+          return window;
+      }
+
+      // unsigned difference orders the stamps across a wrap
+      if((old_epoch == NULL) || ((uint32_t) (dedup->stamp - window->stamp) > (uint32_t) (dedup->stamp - old_epoch->stamp)))
+      {
+          old_epoch = window;
+      }
+  }
+
+  // the other epochs of the remote are kept while there is room, so late
+  // copies sent before a reboot still hit their own window
+  window = (free_window != NULL) ? free_window : old_epoch;
+  if(window == NULL)
+  {
+      return NULL;
+  }
+
+  memcpy(window->eui64, eui64, sizeof(window->eui64));
+  window->in_use  = true;
+  window->epoch   = epoch;
+  window->last    = 0;
+  window->seen    = 0;
+  window->stamp   = dedup->stamp;
+
+  return window;
+}
+
+bool click_dedup_accept(click_dedup_t* dedup, click_window_t* window, uint16_t seq)
+{
+  uint16_t delta;
+  uint16_t shift;
+
+  // a new window starts at 0, seqs run from 1 after boot. one joining a
+  // remote far into its run, after a base station reboot or a failover,
+  // starts a full bitmap before the first seq it gets: it isn't taken as a
+  // wrapped old one, and the earlier clicks still pending on the remote are
+  // neither refused nor covered by the ack
+  if((window->last == 0) && (window->seen == 0) && (seq > 32))
+  {
+      window->last = seq - 1 - 32;
+  }
+
+  delta = (uint16_t) (seq - window->last);
+
+  // at or before last
+  if((delta == 0) || (delta > 0x8000))
+  {
+      return false;
+  }
+
+  // beyond the bitmap, give up on the oldest missing seqs
+  if(delta > 32)
+  {
+      shift         = delta - 32;
+      window->seen  = (shift >= 32) ? 0 : (window->seen >> shift);
+      window->last += shift;
+      delta         = 32;
+  }
+
+  if(window->seen & (1u << (delta - 1)))
+  {
+      return false;
+  }
+
+  window->seen |= (1u << (delta - 1));
+
+  // advance last over the seqs that no longer have a gap before them
+  while(window->seen & 1)
+  {
+      window->seen >>= 1;
+      window->last++;
+  }
+
+  window->stamp = ++dedup->stamp;
+
+  return true;
+}
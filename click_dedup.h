@@ -0,0 +1,75 @@
+/***************************************************************************//**
+ * @file
+ * @brief Click Deduplication Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef CLICK_DEDUP_H_
+#define CLICK_DEDUP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Counts the clicks of each remote exactly once. A remote numbers its clicks
+// from 1 at every boot and sends a random boot epoch along, so a window is
+// kept per (EUI-64, epoch) pair and a rebooted remote starts a new one
+// instead of being mistaken for late copies of its old clicks.
+//
+// last is the highest seq counted without gaps, bit n of seen stands for
+// last + 1 + n. the pair is also what the base station acks
+typedef struct {
+  bool      in_use;
+  uint8_t   eui64[8];
+  uint16_t  epoch;
+  uint16_t  last;
+  uint32_t  seen;
+  uint32_t  stamp;      // table stamp of the last click, older epochs go first
+} click_window_t;
+
+// windows is caller owned storage, sized for the remotes of the deployment
+typedef struct {
+  click_window_t*   windows;
+  uint32_t          count;
+  uint32_t          stamp;
+} click_dedup_t;
+
+void            click_dedup_init(click_dedup_t* dedup, click_window_t* windows, uint32_t count);
+
+// window of the pair. a new pair takes a free window or the least recently
+// used one of the same remote, NULL when neither exists: an unknown remote
+// is refused rather than evicting a known one
+click_window_t* click_dedup_lookup(click_dedup_t* dedup, const uint8_t* eui64, uint16_t epoch);
+
+// true when seq hasn't been counted in the window yet
+bool            click_dedup_accept(click_dedup_t* dedup, click_window_t* window, uint16_t seq);
+
+#endif /* CLICK_DEDUP_H_ */
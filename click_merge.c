@@ -0,0 +1,93 @@
+/***************************************************************************//**
+ * @file
+ * @brief Click Merging
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include "click_merge.h"
+
+void click_merge_init(click_merge_t* merge, uint32_t window_ms)
+{
+  merge->window_ms  = window_ms;
+  merge->answer     = 0;
+  merge->sent       = 0;
+  merge->due        = false;
+  merge->open       = false;
+}
+
+bool click_merge_press(click_merge_t* merge, char answer)
+{
+  merge->answer = answer;
+
+  if(merge->open)
+  {
+      return false;
+  }
+
+  // leading edge, the window only opens when there is one to open
+  merge->due  = true;
+  merge->open = (merge->window_ms != 0);
+
+  return merge->open;
+}
+
+bool click_merge_window_end(click_merge_t* merge)
+{
+  // a press changed the answer since it was last sent, the window goes on
+  if((merge->answer != 0) && (merge->answer != merge->sent))
+  {
+      merge->due = true;
+      return true;
+  }
+
+  merge->answer = 0;
+  merge->sent   = 0;
+  merge->open   = false;
+
+  return false;
+}
+
+char click_merge_take(click_merge_t* merge)
+{
+  char answer = merge->answer;
+
+  if(!merge->due || (answer == 0))
+  {
+      return 0;
+  }
+
+  merge->answer = 0;
+  merge->due    = false;
+  merge->sent   = answer;
+
+  return answer;
+}
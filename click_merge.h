@@ -0,0 +1,69 @@
+/***************************************************************************//**
+ * @file
+ * @brief Click Merging Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef CLICK_MERGE_H_
+#define CLICK_MERGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Merges quick answer changes into few clicks. the first press after a quiet
+// window goes out right away and opens a window, presses within it only
+// replace the answer (last writer wins). when the window ends an answer that
+// differs from the last one sent goes out and opens the next window, so a
+// student changing their mind costs one click per window at most.
+//
+// no clock and no locking, the caller runs the window timer and keeps the
+// calls from interrupting each other
+typedef struct {
+  uint32_t  window_ms;    // 0 opens no window, each press is due at once
+  char      answer;       // waiting to be taken, 0 when there is none
+  char      sent;         // last answer taken in the open window
+  bool      due;          // answer is to be taken now
+  bool      open;
+} click_merge_t;
+
+void  click_merge_init(click_merge_t* merge, uint32_t window_ms);
+
+// a button press, true when the window timer has to be started
+bool  click_merge_press(click_merge_t* merge, char answer);
+
+// the window timer ran out, true when it has to be started again
+bool  click_merge_window_end(click_merge_t* merge);
+
+// answer to send now, 0 when there is none
+char  click_merge_take(click_merge_t* merge);
+
+#endif /* CLICK_MERGE_H_ */
@@ -35,57 +35,463 @@
  ******************************************************************************/
 
 #include <openthread/coap.h>
-#include <openthread/thread.h>
+#include <openthread/instance.h>
+#include <openthread/ip6.h>
+#include <openthread/netdata.h>
+#include <openthread/random_noncrypto.h>
+#include <openthread/thread_ftd.h>
 
 #include <string.h>
 
-#include "printf.h"
+#include "sl_sleeptimer.h"
+
+#include "base_station_select.h"
+#include "coap_client.h"
+#include "coap_rto.h"
+#include "coap_uri.h"
+#include "remote_config.h"
+#include "remote_log.h"
 
 static uint8_t  coap_enabled  = false;
 static char*    uri_path      = "question/answer";
 
+// uri_path split once at init, see coap_uri.h
+static coap_uri_segment_t uri_segments[COAP_URI_MAX_SEGMENTS];
+static uint8_t            uri_segment_count;
+
+// destination of the requests, resolved on the first send after a change
+// that can move the base station
+static otMessageInfo  dest_info;
+static bool           dest_valid    = false;
+
+// base station server that let a request time out, passed over for the
+// others until the network data changes
+static uint16_t       failed_rloc16 = BASE_STATION_RLOC16_INVALID;
+
+// outstanding confirmable request, the slot is the response handler context
+typedef struct {
+  bool      in_use;
+  uint16_t  seq;
+  uint32_t  sent_tick;
+  uint32_t  ack_timeout_ms;   // tells a retransmitted request by its RTT
+  uint16_t  rloc16;           // destination it was sent to
+} in_flight_t;
+
+static in_flight_t          in_flight[COAP_CLIENT_MAX_IN_FLIGHT];
+static coap_client_stats_t  stats   = { .rtt_min_ms = UINT32_MAX, .rto_ms = COAP_CLIENT_RTO_INITIAL_MS };
+
+// CoCoA state for the current destination
+static coap_rto_t           rto;
+static uint32_t             rto_updated_tick;
+
+// told about clicks the base station never acknowledged
+static coap_client_give_up_callback_t give_up_callback;
+static void*                          give_up_context;
+
+#if COAP_CLIENT_NON_MODE
+// click waiting for the base station's cumulative ack, oldest first
+typedef struct {
+  uint16_t  seq;
+  uint8_t   length;
+  uint8_t   tries;          // transmissions so far
+  bool      acked;          // selectively acked, dropped once it is the oldest
+  uint16_t  backoff_ms;     // wait after the last transmission, before jitter
+  uint32_t  queued_tick;
+  uint32_t  retry_tick;     // when the next transmission or the give up is due
+  uint16_t  rloc16;         // destination of the last transmission
+  uint8_t   payload[COAP_CLIENT_NON_MAX_PAYLOAD];
+} non_pending_t;
+
+static void coap_client_ack_handler(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo);
+static void non_retry_timer_callback(sl_sleeptimer_timer_handle_t *handle, void *data);
+static uint32_t non_retry_wait_ms(uint16_t backoff_ms);
+
+// appended by coap_client_send_message, retried by coap_client_process
+static non_pending_t        non_pending[COAP_CLIENT_NON_WINDOW];
+static uint32_t             non_head;
+static uint32_t             non_count;
+
+static sl_sleeptimer_timer_handle_t non_retry_timer;
+static bool                 non_retry_armed;
+static uint32_t             non_retry_armed_tick;
+
+static otCoapResource       ack_resource = {
+    .mUriPath   = COAP_CLIENT_ACK_URI_PATH,
+    .mHandler   = coap_client_ack_handler,
+    .mContext   = NULL,
+    .mNext      = NULL,
+};
+#endif
+
 static void coap_client_handler(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult);
+static otError coap_client_resolve_destination(otInstance *aInstance);
+static uint8_t coap_client_path_cost(otInstance *aInstance, uint16_t rloc16);
+static otError coap_client_find_base_station(otInstance *aInstance, uint16_t *rloc16);
+static uint16_t coap_client_destination_rloc16(void);
+static void coap_client_destination_failed(uint16_t rloc16);
+static in_flight_t* coap_client_track(void);
+static void coap_client_record(in_flight_t* request, otError aResult);
+static void coap_client_account_rtt(uint32_t rtt_ms);
+static otError coap_client_post(otInstance *aInstance, otCoapType message_type, const uint8_t* payload, uint16_t length, uint16_t seq);
+static void coap_client_rto_reset(void);
+static void coap_client_rto_update(uint32_t rtt_ms, uint32_t ack_timeout_ms);
+#if COAP_CLIENT_ADAPTIVE_RTO
+static void coap_client_tx_parameters(otCoapTxParameters* params);
+#endif
+static void coap_client_give_up(uint16_t seq);
 
 otError coap_client_init(otInstance *aInstance)
 {
   otError error = OT_ERROR_NONE;
 
+  coap_rto_init(&rto, COAP_CLIENT_RTO_INITIAL_MS, OT_COAP_MIN_ACK_TIMEOUT, COAP_CLIENT_RTO_MAX_MS);
+
+  if(coap_uri_split(uri_path, uri_segments, &uri_segment_count) != SL_STATUS_OK)
+  {
+      error = OT_ERROR_NO_BUFS;
+      REMOTE_LOG_ERROR(REMOTE_LOG_COAP_URI_PATH, error);
+      return error;
+  }
+
   // start coap
   error = otCoapStart(aInstance, OT_DEFAULT_COAP_PORT);
-  printf("coap client start: %s\r\n", otThreadErrorToString(error));
+  REMOTE_LOG_INFO(REMOTE_LOG_COAP_START, error);
 
   if(!error)
   {
       coap_enabled = true;
+
+#if COAP_CLIENT_NON_MODE
+      // the base station acks non-confirmable clicks here
+      otCoapAddResource(aInstance, &ack_resource);
+#endif
   }
 
 
   return error;
 }
 
-otError coap_client_send_message(otInstance *aInstance, char* message)
+void coap_client_set_give_up_callback(coap_client_give_up_callback_t callback, void* context)
 {
-  otError         error             = OT_ERROR_NONE;
+  give_up_callback  = callback;
+  give_up_context   = context;
+}
+
+static void coap_client_give_up(uint16_t seq)
+{
+  if(give_up_callback != NULL)
+  {
+      give_up_callback(give_up_context, seq);
+  }
+}
+
+void coap_client_state_changed(otChangedFlags flags)
+{
+  // a new role, partition or mesh-local prefix can change the leader RLOC,
+  // network data changes can add, move or remove a base station service
+  if(flags & (OT_CHANGED_THREAD_ROLE | OT_CHANGED_THREAD_PARTITION_ID |
+              OT_CHANGED_THREAD_ML_ADDR | OT_CHANGED_THREAD_NETDATA))
+  {
+      dest_valid = false;
+  }
+
+  // the servers were registered again, give the failed one another chance
+  if(flags & OT_CHANGED_THREAD_NETDATA)
+  {
+      failed_rloc16 = BASE_STATION_RLOC16_INVALID;
+  }
+}
+
+// the destination is an RLOC, its last 16 bits identify the node
+static uint16_t coap_client_destination_rloc16(void)
+{
+  return (uint16_t) ((dest_info.mPeerAddr.mFields.m8[14] << 8) | dest_info.mPeerAddr.mFields.m8[15]);
+}
+
+// rloc16 didn't answer, look the destination up again on the next send and
+// prefer any other server. a request can time out long after the destination
+// moved on, only the current destination is passed over
+static void coap_client_destination_failed(uint16_t rloc16)
+{
+  if(!dest_valid || (rloc16 != coap_client_destination_rloc16()))
+  {
+      return;
+  }
+
+  failed_rloc16 = rloc16;
+  dest_valid    = false;
+
+  REMOTE_LOG_INFO(REMOTE_LOG_COAP_BASE_STATION_FAILED, failed_rloc16);
+}
+
+// cost of the route from this device to the node with rloc16
+static uint8_t coap_client_path_cost(otInstance *aInstance, uint16_t rloc16)
+{
+  otRouterInfo router_info;
+  uint8_t      router_cost = BASE_STATION_PATH_COST_UNKNOWN;
+
+  // the router part of the RLOC16 is the top 6 bits
+  if((otThreadGetRouterInfo(aInstance, rloc16 >> 10, &router_info) == OT_ERROR_NONE) &&
+     router_info.mAllocated)
+  {
+      router_cost = router_info.mPathCost;
+  }
+
+  return base_station_path_cost(otThreadGetRloc16(aInstance), rloc16, router_cost);
+}
+
+// pick the base station server with the lowest path cost from the network
+// data, see base_station_select.h
+static otError coap_client_find_base_station(otInstance *aInstance, uint16_t *rloc16)
+{
+  static const uint8_t  service_data[]  = BASE_STATION_SERVICE_DATA;
+
+  otNetworkDataIterator iterator        = OT_NETWORK_DATA_ITERATOR_INIT;
+  otServiceConfig       config;
+  base_station_select_t select;
+
+  base_station_select_init(&select, failed_rloc16);
+
+  while(otNetDataGetNextService(aInstance, &iterator, &config) == OT_ERROR_NONE)
+  {
+      // service data is matched without the string terminator
+      if((config.mEnterpriseNumber != BASE_STATION_ENTERPRISE_NUMBER) ||
+         (config.mServiceDataLength != sizeof(service_data) - 1) ||
+         (memcmp(config.mServiceData, service_data, sizeof(service_data) - 1) != 0))
+      {
+          continue;
+      }
+
+      base_station_select_offer(&select, config.mServerConfig.mRloc16,
+                                coap_client_path_cost(aInstance, config.mServerConfig.mRloc16));
+  }
+
+  return base_station_select_result(&select, rloc16) ? OT_ERROR_NONE : OT_ERROR_NOT_FOUND;
+}
+
+static otError coap_client_resolve_destination(otInstance *aInstance)
+{
+  otError                  error = OT_ERROR_NONE;
+  uint16_t                 rloc16;
+  const otMeshLocalPrefix* prefix;
+  otIp6Address             previous;
+
+  if(dest_valid)
+  {
+      goto exit;
+  }
+
+  previous = dest_info.mPeerAddr;
+
+  // set destination address and udp port
+  memset(&dest_info, 0, sizeof(dest_info));
+  dest_info.mPeerPort = OT_DEFAULT_COAP_PORT;
+
+  if(coap_client_find_base_station(aInstance, &rloc16) == OT_ERROR_NONE)
+  {
+      // RLOC is mesh-local prefix + 0000:00ff:fe00:rloc16
+      prefix = otThreadGetMeshLocalPrefix(aInstance);
+      memcpy(dest_info.mPeerAddr.mFields.m8, prefix->m8, sizeof(prefix->m8));
+      dest_info.mPeerAddr.mFields.m8[11] = 0xff;
+      dest_info.mPeerAddr.mFields.m8[12] = 0xfe;
+      dest_info.mPeerAddr.mFields.m8[14] = (uint8_t) (rloc16 >> 8);
+      dest_info.mPeerAddr.mFields.m8[15] = (uint8_t) rloc16;
+
+      REMOTE_LOG_INFO(REMOTE_LOG_COAP_BASE_STATION, rloc16);
+  }
+  else
+  {
+      // no base station service registered, assume the leader
+      error = otThreadGetLeaderRloc(aInstance, &dest_info.mPeerAddr);
+      if(error)
+      {
+          REMOTE_LOG_ERROR(REMOTE_LOG_COAP_LEADER_RLOC, error);
+          goto exit;
+      }
+  }
+
+  // RTT measurements only apply to the node they were taken with
+  if(memcmp(&previous, &dest_info.mPeerAddr, sizeof(previous)) != 0)
+  {
+      coap_client_rto_reset();
+  }
+
+  dest_valid = true;
+
+exit:
+  return error;
+}
+
+static void coap_client_rto_reset(void)
+{
+  coap_rto_reset(&rto);
+  stats.rto_ms      = coap_rto_ack_timeout(&rto);
+  rto_updated_tick  = sl_sleeptimer_get_tick_count();
+}
 
-  otCoapType      message_type      = OT_COAP_TYPE_CONFIRMABLE;
+static void coap_client_rto_update(uint32_t rtt_ms, uint32_t ack_timeout_ms)
+{
+  if(coap_rto_update(&rto, rtt_ms, ack_timeout_ms) != COAP_RTO_SAMPLE_DROPPED)
+  {
+      stats.rto_ms      = coap_rto_ack_timeout(&rto);
+      rto_updated_tick  = sl_sleeptimer_get_tick_count();
+  }
+}
+
+#if COAP_CLIENT_ADAPTIVE_RTO
+// tx parameters for the next request, ages an RTO that hasn't been updated
+// for a while back towards the default
+static void coap_client_tx_parameters(otCoapTxParameters* params)
+{
+  uint32_t idle_ms;
+  uint32_t ack_timeout;
+
+  idle_ms = sl_sleeptimer_tick_to_ms(sl_sleeptimer_get_tick_count() - rto_updated_tick);
+
+  if(coap_rto_age(&rto, idle_ms))
+  {
+      rto_updated_tick = sl_sleeptimer_get_tick_count();
+  }
+
+  // bounded by OT_COAP_MIN_ACK_TIMEOUT, OpenThread rejects anything less
+  ack_timeout   = coap_rto_ack_timeout(&rto);
+  stats.rto_ms  = ack_timeout;
+
+  params->mAckTimeout                 = ack_timeout;
+  params->mAckRandomFactorNumerator   = COAP_RTO_RANDOM_FACTOR_NUM;
+  params->mAckRandomFactorDenominator = COAP_RTO_RANDOM_FACTOR_DEN;
+  params->mMaxRetransmit              = COAP_RTO_MAX_RETRANSMIT;
+}
+#endif
+
+// claim an in-flight slot and timestamp it, NULL when the table is full
+static in_flight_t* coap_client_track(void)
+{
+  in_flight_t* request = NULL;
+
+  for(uint32_t i = 0; i < COAP_CLIENT_MAX_IN_FLIGHT; i++)
+  {
+      if(!in_flight[i].in_use)
+      {
+          request             = &in_flight[i];
+          request->in_use     = true;
+          request->sent_tick  = sl_sleeptimer_get_tick_count();
+          stats.in_flight++;
+          break;
+      }
+  }
+
+  if(request == NULL)
+  {
+      stats.untracked++;
+  }
+
+  return request;
+}
+
+// add an RTT to the histogram
+static void coap_client_account_rtt(uint32_t rtt_ms)
+{
+  uint32_t bucket = 0;
+  uint32_t limit  = COAP_CLIENT_RTT_BUCKET_MS;
+
+  while((rtt_ms >= limit) && (bucket < (COAP_CLIENT_RTT_BUCKETS - 1)))
+  {
+      limit <<= 1;
+      bucket++;
+  }
+
+  stats.rtt_histogram[bucket]++;
+  stats.rtt_min_ms = (rtt_ms < stats.rtt_min_ms) ? rtt_ms : stats.rtt_min_ms;
+  stats.rtt_max_ms = (rtt_ms > stats.rtt_max_ms) ? rtt_ms : stats.rtt_max_ms;
+}
+
+// account for the result of a request, request is NULL for untracked ones
+static void coap_client_record(in_flight_t* request, otError aResult)
+{
+  coap_client_result_t  result;
+  uint32_t              rtt_ms;
+
+  switch(aResult)
+  {
+    case OT_ERROR_NONE:
+      result = COAP_CLIENT_RESULT_ACK;
+      break;
+
+    // OpenThread reports a reset from the peer as an abort
+    case OT_ERROR_ABORT:
+      result = COAP_CLIENT_RESULT_RST;
+      break;
+
+    case OT_ERROR_RESPONSE_TIMEOUT:
+      result = COAP_CLIENT_RESULT_TIMEOUT;
+      break;
+
+    default:
+      result = COAP_CLIENT_RESULT_OTHER;
+      break;
+  }
+
+  stats.results[result]++;
+
+  if(request != NULL)
+  {
+      // unsigned difference stays correct across a tick counter wrap
+      rtt_ms = sl_sleeptimer_tick_to_ms(sl_sleeptimer_get_tick_count() - request->sent_tick);
+
+      request->in_use = false;
+      stats.in_flight--;
+
+      // the RTT of a retransmitted request includes the retransmission wait.
+      // the estimate was reset when the destination moved, an answer from the
+      // one before it says nothing about the new one
+      if((result == COAP_CLIENT_RESULT_ACK) || (result == COAP_CLIENT_RESULT_RST))
+      {
+          coap_client_account_rtt(rtt_ms);
+
+          if(request->rloc16 == coap_client_destination_rloc16())
+          {
+              coap_client_rto_update(rtt_ms, request->ack_timeout_ms);
+          }
+      }
+  }
+}
+
+sl_status_t coap_client_get_stats(coap_client_stats_t* out)
+{
+  if(out == NULL)
+  {
+      return SL_STATUS_NULL_POINTER;
+  }
+
+  *out = stats;
+
+  return SL_STATUS_OK;
+}
+
+// build and send a POST to the base station, confirmable requests are
+// tracked and get an adaptive ACK timeout
+static otError coap_client_post(otInstance *aInstance, otCoapType message_type, const uint8_t* payload, uint16_t length, uint16_t seq)
+{
+  otError         error             = OT_ERROR_NONE;
 
   otMessage       *request_message  = NULL;
-  otMessageInfo   message_info;
+  in_flight_t     *request          = NULL;
 
-  otIp6Address    dest_addr;
+  otCoapTxParameters  tx_params;
+  otCoapTxParameters  *tx_params_ptr = NULL;
 
   // verify coap has been enabled
   if(!coap_enabled)
   {
       error = OT_ERROR_INVALID_STATE;
-      printf("coap not enabled\r\n");
+      REMOTE_LOG_ERROR(REMOTE_LOG_COAP_NOT_ENABLED);
       goto exit;
   }
 
-  error = otThreadGetLeaderRloc(aInstance, &dest_addr);
+  error = coap_client_resolve_destination(aInstance);
   if(error)
   {
-      printf("get leader rloc: %s\r\n", otThreadErrorToString(error));
       goto exit;
   }
 
@@ -93,7 +499,7 @@ otError coap_client_send_message(otInstance *aInstance, char* message)
   if(request_message == NULL)
   {
       error = OT_ERROR_NO_BUFS;
-      printf("coap request init message: %s\r\n", otThreadErrorToString(error));
+      REMOTE_LOG_ERROR(REMOTE_LOG_COAP_NEW_MESSAGE, error);
       goto exit;
   }
 
@@ -101,63 +507,327 @@ otError coap_client_send_message(otInstance *aInstance, char* message)
   otCoapMessageGenerateToken(request_message, OT_COAP_DEFAULT_TOKEN_LENGTH);
 
   // set URI path for requested resource
-  error = otCoapMessageAppendUriPathOptions(request_message, uri_path);
-  if(error)
+  for(uint8_t i = 0; i < uri_segment_count; i++)
   {
-      printf("coap request append uri-path: %s\r\n", otThreadErrorToString(error));
-      goto exit;
+      error = otCoapMessageAppendOption(request_message, OT_COAP_OPTION_URI_PATH,
+                                        uri_segments[i].length, uri_segments[i].value);
+      if(error)
+      {
+          REMOTE_LOG_ERROR(REMOTE_LOG_COAP_URI_PATH, error);
+          goto exit;
+      }
   }
 
   // set payload marker to indicate beginning of payload in coap message
   error = otCoapMessageSetPayloadMarker(request_message);
   if(error)
   {
-      printf("set payload marker: %s\r\n", otThreadErrorToString(error));
+      REMOTE_LOG_ERROR(REMOTE_LOG_COAP_PAYLOAD_MARKER, error);
       goto exit;
   }
 
-  printf("message to append: %s, len: %d\r\n", message, strlen(message));
-
   // add message
-  error = otMessageAppend(request_message, message, strlen(message));
+  error = otMessageAppend(request_message, payload, length);
   if(error)
   {
-      printf("append payload to message: %s\r\n", otThreadErrorToString(error));
+      REMOTE_LOG_ERROR(REMOTE_LOG_COAP_APPEND_PAYLOAD, error);
       goto exit;
   }
 
-  // set destination address and udp port
-  memset(&message_info, 0, sizeof(message_info));
-  message_info.mPeerAddr = dest_addr;
-  message_info.mPeerPort = OT_DEFAULT_COAP_PORT;
+  REMOTE_LOG_INFO(REMOTE_LOG_COAP_TX, length, coap_client_destination_rloc16());
+
+  // non-confirmable requests get no response, nothing to track
+  if(message_type != OT_COAP_TYPE_CONFIRMABLE)
+  {
+      error = otCoapSendRequestWithParameters(aInstance, request_message, &dest_info, NULL, NULL, NULL);
+      if(error)
+      {
+          REMOTE_LOG_ERROR(REMOTE_LOG_COAP_SEND, error);
+          goto exit;
+      }
+
+      stats.sent++;
+      goto exit;
+  }
+
+  // send coap request, the in-flight slot comes back as the handler context
+  request = coap_client_track();
 
-  char dest_addr_str[OT_IP6_ADDRESS_STRING_SIZE];
-  otIp6AddressToString((otIp6Address *) &dest_addr, (char *) &dest_addr_str, OT_IP6_ADDRESS_STRING_SIZE);
-  printf("sending '%s' to %s\r\n", message, dest_addr_str);
+#if COAP_CLIENT_ADAPTIVE_RTO
+  coap_client_tx_parameters(&tx_params);
+  tx_params_ptr = &tx_params;
+#else
+  // the OpenThread default
+  tx_params.mAckTimeout = COAP_CLIENT_RTO_INITIAL_MS;
+#endif
 
-  // send coap request
-  error = otCoapSendRequestWithParameters(aInstance, request_message, &message_info, &coap_client_handler, aInstance, NULL);
+  if(request != NULL)
+  {
+      request->seq            = seq;
+      request->ack_timeout_ms = tx_params.mAckTimeout;
+      request->rloc16         = coap_client_destination_rloc16();
+  }
+
+  error = otCoapSendRequestWithParameters(aInstance, request_message, &dest_info, &coap_client_handler, request, tx_params_ptr);
   if(error)
   {
-      printf("send coap request: %s\r\n", otThreadErrorToString(error));
+      REMOTE_LOG_ERROR(REMOTE_LOG_COAP_SEND, error);
       goto exit;
   }
 
+  stats.sent++;
+
 exit:
-  if(error != OT_ERROR_NONE && request_message != NULL)
+  if(error != OT_ERROR_NONE)
   {
-      otMessageFree(request_message);
+      stats.send_failed++;
+
+      // never sent, no result will come for the slot
+      if(request != NULL)
+      {
+          request->in_use = false;
+          stats.in_flight--;
+      }
+
+      if(request_message != NULL)
+      {
+          otMessageFree(request_message);
+      }
   }
 
   return error;
 }
 
 
+otError coap_client_send_message(otInstance *aInstance, const uint8_t* payload, uint16_t length, uint16_t seq)
+{
+#if COAP_CLIENT_NON_MODE
+  otError error = OT_ERROR_NONE;
+
+  (void) aInstance;
+
+  if(length > COAP_CLIENT_NON_MAX_PAYLOAD)
+  {
+      return OT_ERROR_INVALID_ARGS;
+  }
+
+  // queue only, the next coap_client_process pass sends it
+  if(non_count == COAP_CLIENT_NON_WINDOW)
+  {
+      stats.send_failed++;
+      error = OT_ERROR_BUSY;
+  }
+  else
+  {
+      non_pending_t* click = &non_pending[(non_head + non_count) % COAP_CLIENT_NON_WINDOW];
+
+      click->seq          = seq;
+      click->length       = (uint8_t) length;
+      click->tries        = 0;
+      click->acked        = false;
+      click->queued_tick  = sl_sleeptimer_get_tick_count();
+      memcpy(click->payload, payload, length);
+
+      non_count++;
+  }
+
+  return error;
+#else
+  return coap_client_post(aInstance, OT_COAP_TYPE_CONFIRMABLE, payload, length, seq);
+#endif
+}
+
+#if COAP_CLIENT_NON_MODE
+static void non_retry_timer_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+  (void) handle;
+  (void) data;
+
+  // only wakes the main loop, coap_client_process checks the due ticks
+}
+
+// backoff_ms stretched by a random factor of up to 1.5, as RFC 7252 does for
+// the ACK timeout, so remotes that lost their clicks to the same burst of
+// interference don't retry in lockstep
+static uint32_t non_retry_wait_ms(uint16_t backoff_ms)
+{
+  return backoff_ms + (otRandomNonCryptoGetUint32() % ((backoff_ms / 2u) + 1u));
+}
+
+// the base station posts the highest seq it has without gaps, followed by a
+// bitmap of the 32 seqs after it that it has too
+static void coap_client_ack_handler(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo)
+{
+  uint8_t         ack[6];
+  uint16_t        cumulative;
+  uint32_t        received;
+  uint16_t        delta;
+  bool            covered;
+  non_pending_t*  click;
+
+  (void) aContext;
+
+  // only the base station the clicks go to can ack them. one that was passed
+  // over, or a stray node, would stop the retries of clicks it never counted.
+  // while the destination is resolved again the next transmission is acked
+  if(!dest_valid || !otIp6IsAddressEqual(&aMessageInfo->mPeerAddr, &dest_info.mPeerAddr))
+  {
+      REMOTE_LOG_DEBUG(REMOTE_LOG_COAP_NON_ACK_IGNORED,
+                       (aMessageInfo->mPeerAddr.mFields.m8[14] << 8) | aMessageInfo->mPeerAddr.mFields.m8[15]);
+      return;
+  }
+
+  if(otMessageRead(aMessage, otMessageGetOffset(aMessage), ack, sizeof(ack)) != sizeof(ack))
+  {
+      return;
+  }
+
+  cumulative  = (uint16_t) ((ack[0] << 8) | ack[1]);
+  received    = ((uint32_t) ack[2] << 24) | ((uint32_t) ack[3] << 16) | ((uint32_t) ack[4] << 8) | ack[5];
+
+  REMOTE_LOG_DEBUG(REMOTE_LOG_COAP_NON_ACK, cumulative, received);
+
+  for(uint32_t i = 0; i < non_count; i++)
+  {
+      click = &non_pending[(non_head + i) % COAP_CLIENT_NON_WINDOW];
+
+      if(click->acked || (click->tries == 0))
+      {
+          continue;
+      }
+
+      // at or before the cumulative seq, or set in the bitmap
+      delta   = (uint16_t) (click->seq - cumulative);
+      covered = (delta == 0) || (delta > 0x8000) ||
+                ((delta <= 32) && ((received & (1u << (delta - 1))) != 0));
+
+      if(!covered)
+      {
+          continue;
+      }
+
+      click->acked = true;
+
+      stats.results[COAP_CLIENT_RESULT_ACK]++;
+      coap_client_account_rtt(sl_sleeptimer_tick_to_ms(sl_sleeptimer_get_tick_count() - click->queued_tick));
+  }
+}
+#endif
+
+void coap_client_process(otInstance *aInstance)
+{
+#if COAP_CLIENT_NON_MODE
+  uint32_t        now       = sl_sleeptimer_get_tick_count();
+  uint32_t        next_wait = UINT32_MAX;   // ticks until the earliest due click
+  bool            due;
+  non_pending_t*  click;
+
+  // drop acked clicks and the ones whose last transmission went unanswered
+  // from the front
+  while(non_count > 0)
+  {
+      click = &non_pending[non_head];
+      due   = (int32_t) (now - click->retry_tick) >= 0;
+
+      if(!click->acked && ((click->tries < COAP_CLIENT_NON_MAX_TRIES) || !due))
+      {
+          break;
+      }
+
+      if(!click->acked)
+      {
+          REMOTE_LOG_ERROR(REMOTE_LOG_COAP_NON_GIVE_UP, click->seq);
+          stats.results[COAP_CLIENT_RESULT_TIMEOUT]++;
+          coap_client_destination_failed(click->rloc16);
+          coap_client_give_up(click->seq);
+      }
+
+      non_head = (non_head + 1) % COAP_CLIENT_NON_WINDOW;
+      non_count--;
+  }
+
+  // new clicks go out right away, the rest when their backoff ran out. the
+  // backoff doubles with every transmission up to COAP_CLIENT_NON_RETRY_MAX_MS
+  for(uint32_t i = 0; i < non_count; i++)
+  {
+      click = &non_pending[(non_head + i) % COAP_CLIENT_NON_WINDOW];
+      due   = (int32_t) (now - click->retry_tick) >= 0;
+
+      if(click->acked)
+      {
+          continue;
+      }
+
+      if((click->tries == 0) || (due && (click->tries < COAP_CLIENT_NON_MAX_TRIES)))
+      {
+          coap_client_post(aInstance, OT_COAP_TYPE_NON_CONFIRMABLE, click->payload, click->length, click->seq);
+          click->rloc16 = coap_client_destination_rloc16();
+
+          if(click->tries == 0)
+          {
+              click->backoff_ms = COAP_CLIENT_NON_RETRY_MS;
+          }
+          else if(click->backoff_ms < (COAP_CLIENT_NON_RETRY_MAX_MS / 2))
+          {
+              click->backoff_ms *= 2;
+          }
+          else
+          {
+              click->backoff_ms = COAP_CLIENT_NON_RETRY_MAX_MS;
+          }
+
+          click->tries++;
+          click->retry_tick = now + sl_sleeptimer_ms_to_tick((uint16_t) non_retry_wait_ms(click->backoff_ms));
+      }
+      else if(due)
+      {
+          // out of tries and waiting for the ones before it to be dropped
+          continue;
+      }
+
+      if((click->retry_tick - now) < next_wait)
+      {
+          next_wait = click->retry_tick - now;
+      }
+  }
+
+  // one timer for the earliest due click, it only wakes the main loop
+  if(next_wait != UINT32_MAX)
+  {
+      if(!non_retry_armed || (non_retry_armed_tick != now + next_wait))
+      {
+          non_retry_armed       = true;
+          non_retry_armed_tick  = now + next_wait;
+          sl_sleeptimer_restart_timer_ms(&non_retry_timer, sl_sleeptimer_tick_to_ms(next_wait),
+                                         non_retry_timer_callback, NULL, 0, 0);
+      }
+  }
+  else if(non_retry_armed)
+  {
+      non_retry_armed = false;
+      sl_sleeptimer_stop_timer(&non_retry_timer);
+  }
+#else
+  (void) aInstance;
+#endif
+}
+
 static void coap_client_handler(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult)
 {
-  (void)aContext;
+  in_flight_t* request = (in_flight_t *) aContext;
+
   (void)aMessage;
   (void)aMessageInfo;
-  (void)aResult;
-  printf("coap client handler\r\n");
+
+  REMOTE_LOG_INFO(REMOTE_LOG_COAP_RESPONSE, aResult);
+
+  // the base station didn't answer, fail over to another server if there is
+  // one. the seq and destination of an untracked request aren't known
+  if((aResult == OT_ERROR_RESPONSE_TIMEOUT) && (request != NULL))
+  {
+      coap_client_destination_failed(request->rloc16);
+      coap_client_give_up(request->seq);
+  }
+
+  coap_client_record(request, aResult);
 }
@@ -37,7 +37,87 @@
 #ifndef COAP_CLIENT_H_
 #define COAP_CLIENT_H_
 
+#include <stdint.h>
+
+#include "sl_status.h"
+
+// confirmable requests tracked until their response or timeout
+#ifndef COAP_CLIENT_MAX_IN_FLIGHT
+#define COAP_CLIENT_MAX_IN_FLIGHT     4
+#endif
+
+// 1 derives the ACK timeout of each request from the measured RTT (CoCoA),
+// 0 uses the OpenThread defaults
+#ifndef COAP_CLIENT_ADAPTIVE_RTO
+#define COAP_CLIENT_ADAPTIVE_RTO      1
+#endif
+
+#define COAP_CLIENT_RTO_INITIAL_MS    2000    // RFC 7252 ACK_TIMEOUT
+#define COAP_CLIENT_RTO_MAX_MS        32000
+
+// 1 sends clicks non-confirmable. each carries the caller's sequence number
+// and is repeated until the base station acks it on COAP_CLIENT_ACK_URI_PATH,
+// or COAP_CLIENT_NON_MAX_TRIES is reached. the wait starts at
+// COAP_CLIENT_NON_RETRY_MS and doubles up to COAP_CLIENT_NON_RETRY_MAX_MS,
+// each wait is stretched by a random factor of up to 1.5
+#ifndef COAP_CLIENT_NON_MODE
+#define COAP_CLIENT_NON_MODE          0
+#endif
+
+#define COAP_CLIENT_ACK_URI_PATH      "question/ack"
+#define COAP_CLIENT_NON_WINDOW        8       // clicks waiting for an ack
+#define COAP_CLIENT_NON_MAX_PAYLOAD   32
+#define COAP_CLIENT_NON_RETRY_MS      300
+#define COAP_CLIENT_NON_RETRY_MAX_MS  1200
+#define COAP_CLIENT_NON_MAX_TRIES     8
+
+// RTT histogram, bucket 0 holds RTTs below COAP_CLIENT_RTT_BUCKET_MS and each
+// following bucket doubles the limit, the last one takes everything above
+#define COAP_CLIENT_RTT_BUCKET_MS     32
+#define COAP_CLIENT_RTT_BUCKETS       8
+
+typedef enum {
+  COAP_CLIENT_RESULT_ACK,         // response received
+  COAP_CLIENT_RESULT_RST,         // reset by the peer
+  COAP_CLIENT_RESULT_TIMEOUT,     // retransmissions exhausted
+  COAP_CLIENT_RESULT_OTHER,
+  COAP_CLIENT_RESULT_COUNT,
+} coap_client_result_t;
+
+typedef struct {
+  uint32_t  sent;                                   // requests handed to OpenThread
+  uint32_t  send_failed;                            // requests that couldn't be sent
+  uint32_t  untracked;                              // sent while the in-flight table was full
+  uint32_t  in_flight;                              // tracked requests waiting for a result
+  uint32_t  results[COAP_CLIENT_RESULT_COUNT];
+  uint32_t  rtt_min_ms;                             // over ACK and RST results
+  uint32_t  rtt_max_ms;
+  uint32_t  rtt_histogram[COAP_CLIENT_RTT_BUCKETS];
+  uint32_t  rto_ms;                                 // ACK timeout used for the next request
+} coap_client_stats_t;
+
+// everything here runs in the main loop: clicks are sent from remote_process
+// and OpenThread calls the response and ack handlers from its tasklets, so
+// the module state needs no critical sections
 otError coap_client_init(otInstance *aInstance);
-otError coap_client_send_message(otInstance *aInstance, char* message);
+// send a click, seq is handed back to the give up callback and sent along by
+// COAP_CLIENT_NON_MODE. in that mode the click is queued and sent by
+// coap_client_process
+otError coap_client_send_message(otInstance *aInstance, const uint8_t* payload, uint16_t length, uint16_t seq);
+
+// retransmission of non-confirmable clicks, call from the main loop
+void    coap_client_process(otInstance *aInstance);
+
+// seq of a click the base station never acknowledged: a non-confirmable one
+// out of tries, or a confirmable one that timed out. called from the main loop
+typedef void (*coap_client_give_up_callback_t)(void* context, uint16_t seq);
+
+void    coap_client_set_give_up_callback(coap_client_give_up_callback_t callback, void* context);
+
+// forward OpenThread state changes, drops the cached destination when it
+// may have moved
+void    coap_client_state_changed(otChangedFlags flags);
+
+sl_status_t coap_client_get_stats(coap_client_stats_t* stats);
 
 #endif /* COAP_CLIENT_H_ */
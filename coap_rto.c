@@ -0,0 +1,137 @@
+/***************************************************************************//**
+ * @file
+ * @brief CoAP Retransmission Timeout
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include "coap_rto.h"
+
+void coap_rto_init(coap_rto_t* rto, uint32_t initial_ms, uint32_t min_ms, uint32_t max_ms)
+{
+  rto->initial_ms = initial_ms;
+  rto->min_ms     = min_ms;
+  rto->max_ms     = max_ms;
+
+  coap_rto_reset(rto);
+}
+
+void coap_rto_reset(coap_rto_t* rto)
+{
+  rto->strong.valid = false;
+  rto->weak.valid   = false;
+  rto->rto_ms       = rto->initial_ms;
+}
+
+// feed one RTT sample into an estimator, returns SRTT + k * RTTVAR
+static uint32_t coap_rto_estimator_update(coap_rto_estimator_t* estimator, uint32_t rtt_ms, uint32_t k)
+{
+  uint32_t delta;
+
+  if(!estimator->valid)
+  {
+      estimator->valid      = true;
+      estimator->srtt_ms    = rtt_ms;
+      estimator->rttvar_ms  = rtt_ms / 2;
+  }
+  else
+  {
+      delta = (estimator->srtt_ms > rtt_ms) ? (estimator->srtt_ms - rtt_ms) : (rtt_ms - estimator->srtt_ms);
+
+      // beta 1/4, alpha 1/8
+      estimator->rttvar_ms  = ((3 * estimator->rttvar_ms) + delta) / 4;
+      estimator->srtt_ms    = ((7 * estimator->srtt_ms) + rtt_ms) / 8;
+  }
+
+  return estimator->srtt_ms + (k * estimator->rttvar_ms);
+}
+
+// OpenThread doesn't report how often a request went out, so the count is
+// inferred from the RTT. with T the ACK timeout the first retransmission
+// leaves at a random time in [T, 3T/2) and each later wait doubles: below T
+// nothing was retransmitted yet, the third retransmission leaves at 7T at
+// the earliest. a response in [T, 3T/2) may answer the first transmission,
+// it is taken as weak all the same since RTO too short for the path shows up
+// in exactly that band and the weak estimator is what lifts it
+coap_rto_sample_t coap_rto_update(coap_rto_t* rto, uint32_t rtt_ms, uint32_t ack_timeout_ms)
+{
+  uint32_t estimate;
+
+  if(rtt_ms < ack_timeout_ms)
+  {
+      estimate    = coap_rto_estimator_update(&rto->strong, rtt_ms, 4);
+      rto->rto_ms = (rto->rto_ms + estimate) / 2;
+
+      return COAP_RTO_SAMPLE_STRONG;
+  }
+
+  if(rtt_ms >= (7 * ack_timeout_ms))
+  {
+      return COAP_RTO_SAMPLE_DROPPED;
+  }
+
+  estimate    = coap_rto_estimator_update(&rto->weak, rtt_ms, 1);
+  rto->rto_ms = ((3 * rto->rto_ms) + estimate) / 4;
+
+  return COAP_RTO_SAMPLE_WEAK;
+}
+
+bool coap_rto_age(coap_rto_t* rto, uint32_t idle_ms)
+{
+  if((rto->rto_ms < 1000) && (idle_ms > (16 * rto->rto_ms)))
+  {
+      rto->rto_ms = 2 * rto->rto_ms;
+      return true;
+  }
+
+  if((rto->rto_ms > 3000) && (idle_ms > (4 * rto->rto_ms)))
+  {
+      rto->rto_ms = 1000 + (rto->rto_ms / 2);
+      return true;
+  }
+
+  return false;
+}
+
+uint32_t coap_rto_ack_timeout(const coap_rto_t* rto)
+{
+  if(rto->rto_ms < rto->min_ms)
+  {
+      return rto->min_ms;
+  }
+
+  if(rto->rto_ms > rto->max_ms)
+  {
+      return rto->max_ms;
+  }
+
+  return rto->rto_ms;
+}
@@ -0,0 +1,92 @@
+/***************************************************************************//**
+ * @file
+ * @brief CoAP Retransmission Timeout Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef COAP_RTO_H_
+#define COAP_RTO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// CoCoA retransmission timeout of one destination. the strong estimator
+// learns from requests answered before any retransmission, the weak one
+// from the rest with the RTT measured from the first transmission. plain
+// arithmetic on elapsed times, the caller owns the clock and the locking
+
+// transmission parameters the RTO is used with, RFC 7252 ACK_RANDOM_FACTOR
+// and MAX_RETRANSMIT
+#define COAP_RTO_RANDOM_FACTOR_NUM    3
+#define COAP_RTO_RANDOM_FACTOR_DEN    2
+#define COAP_RTO_MAX_RETRANSMIT       4
+
+// RFC 6298 smoothed RTT and variance, in ms
+typedef struct {
+  bool      valid;
+  uint32_t  srtt_ms;
+  uint32_t  rttvar_ms;
+} coap_rto_estimator_t;
+
+typedef struct {
+  coap_rto_estimator_t  strong;
+  coap_rto_estimator_t  weak;
+  uint32_t              rto_ms;       // before the bounds
+  uint32_t              initial_ms;
+  uint32_t              min_ms;
+  uint32_t              max_ms;
+} coap_rto_t;
+
+// what a response told the estimators
+typedef enum {
+  COAP_RTO_SAMPLE_STRONG,     // answered before the first retransmission
+  COAP_RTO_SAMPLE_WEAK,       // answered after one or two retransmissions
+  COAP_RTO_SAMPLE_DROPPED,    // may have taken more, CoCoA ignores those
+} coap_rto_sample_t;
+
+void              coap_rto_init(coap_rto_t* rto, uint32_t initial_ms, uint32_t min_ms, uint32_t max_ms);
+
+// back to initial_ms, the estimates belong to another destination
+void              coap_rto_reset(coap_rto_t* rto);
+
+// feed the RTT of a request sent with ack_timeout_ms, measured from its
+// first transmission. the caller restarts its idle clock unless dropped
+coap_rto_sample_t coap_rto_update(coap_rto_t* rto, uint32_t rtt_ms, uint32_t ack_timeout_ms);
+
+// age an RTO that went idle_ms without an update back towards the default,
+// true when it did and the caller restarts its idle clock
+bool              coap_rto_age(coap_rto_t* rto, uint32_t idle_ms);
+
+// ACK timeout for the next request, within the bounds
+uint32_t          coap_rto_ack_timeout(const coap_rto_t* rto);
+
+#endif /* COAP_RTO_H_ */
@@ -0,0 +1,67 @@
+/***************************************************************************//**
+ * @file
+ * @brief CoAP Uri-Path
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include "coap_uri.h"
+
+#include <string.h>
+
+sl_status_t coap_uri_split(const char* path, coap_uri_segment_t* segments, uint8_t* count)
+{
+  const char* end;
+
+  *count = 0;
+
+  while(*path != '\0')
+  {
+      if(*count == COAP_URI_MAX_SEGMENTS)
+      {
+          return SL_STATUS_FULL;
+      }
+
+      end = strchr(path, '/');
+      if(end == NULL)
+      {
+          end = path + strlen(path);
+      }
+
+      segments[*count].value  = path;
+      segments[*count].length = (uint16_t) (end - path);
+      (*count)++;
+
+      path = (*end == '/') ? (end + 1) : end;
+  }
+
+  return SL_STATUS_OK;
+}
@@ -0,0 +1,56 @@
+/***************************************************************************//**
+ * @file
+ * @brief CoAP Uri-Path Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef COAP_URI_H_
+#define COAP_URI_H_
+
+#include <stdint.h>
+
+#include "sl_status.h"
+
+// a path split into its Uri-Path option values once, so a send appends
+// ready made options instead of parsing the path again
+#define COAP_URI_MAX_SEGMENTS   4
+
+typedef struct {
+  const char*   value;      // points into the path, which has to outlive it
+  uint16_t      length;
+} coap_uri_segment_t;
+
+// split path at '/' into segments, SL_STATUS_FULL when it has more than
+// COAP_URI_MAX_SEGMENTS of them
+sl_status_t coap_uri_split(const char* path, coap_uri_segment_t* segments, uint8_t* count);
+
+#endif /* COAP_URI_H_ */
@@ -36,37 +36,77 @@
 
 #include <string.h>
 
-// display drivers and graphics library
+// graphics library, the display driver is only reached through gui_display
 #include "glib.h"
-#include "dmd.h"
 
 // platform includes
-#include "sl_simple_button_instances.h"
 #include "printf.h"
+#include "remote_log.h"
 
 #include "gui.h"
+#include "gui_display.h"
 #include "gui_event_queue.h"
 
 // local functions
-static  void display_init(void);
+static  sl_status_t display_init(void);
+static  void render_glyph(char c, int32_t x, int32_t y);
+static  void draw_glyph(char c, int32_t x, int32_t y);
+static  void text_field_init(text_field_t* field, int32_t x, uint8_t line, int32_t y_offset);
+static  void text_field_set(text_field_t* field, const char* text);
+static  void button_char_position(const button_t* button, int32_t* char_x, int32_t* char_y);
+static  void draw_button_chrome(const button_t* button);
 static  void draw_button(const button_t* button, bool pressed);
+static  void gui_button_event(uint32_t flag);
+static  void gui_render_log(gui_log_id_t id, uint16_t arg, const char* text);
+static  void gui_render_event(const gui_event_t* event);
+static  uint32_t gui_drain_lane(gui_event_lane_t lane, uint32_t budget);
+
+_Static_assert((LOG_VISIBLE_LINES >= 1) && (LOG_VISIBLE_LINES <= LOG_MAX_VISIBLE_LINES),
+               "LOG_VISIBLE_LINES must fit in the log window");
+_Static_assert((LOG_OFFSET_Y + (LOG_LINE * GUI_FONT_LINE_PITCH)) >= LOG_WINDOW_Y_MIN,
+               "the first log line must start inside the log window");
+_Static_assert((LOG_BUFFER_LEN >= LOG_VISIBLE_LINES) && (LOG_BUFFER_LEN <= 16),
+               "LOG_BUFFER_LEN must hold the visible lines and at most 16 entries");
 
 // local vars
 static  char                     log_buffer[LOG_BUFFER_LEN][DISPLAY_LOG_MAX_STR_LEN + 1];
-static  uint8_t                  log_index;
-static  const GLIB_Rectangle_t   log_window = {0, 55, 127, 98};
+static  uint32_t                 log_count;      // lines printed since init
+static  const GLIB_Rectangle_t   log_window = {0, LOG_WINDOW_Y_MIN, 127, LOG_WINDOW_Y_MAX};
 
 static  GLIB_Context_t           glib_context;
-static  bool                     update_display;
+
+static  volatile bool            frame_ready;     // GUI_FRAME_INTERVAL_MS passed since the last flush
+
+static  text_field_t             network_name_field;
+static  text_field_t             network_channel_field;
+static  text_field_t             device_role_field;
+static  text_field_t             mac_addr_field;
 
 static  const button_t           button_left     = {{ 1, 113,  62, 126}, 'A'};
 static  const button_t           button_right    = {{65, 113, 126, 126}, 'B'};
 
+// text for gui_log_id_t, formatted only when rendered
+static  const char* const        gui_log_strings[GUI_LOG_COUNT] = {
+    [GUI_LOG_HELLO]             = "hello :)",
+    [GUI_LOG_READY_TO_JOIN]     = "press 'B' to join",
+    [GUI_LOG_JOINER_SEARCHING]  = "[joiner] searching...",
+    [GUI_LOG_JOINER_JOINED]     = "[joiner] joined :)",
+    [GUI_LOG_JOINER_ERROR]      = "[joiner] %s",
+    [GUI_LOG_COAP_TX]           = "[coap] tx '%c'",
+    [GUI_LOG_COAP_LOST]         = "[coap] click %u lost",
+};
 
-static void display_init(void)
+
+static sl_status_t display_init(void)
 {
-  // initialize dot matrix display driver
-  DMD_init(0);
+  sl_status_t error;
+
+  // initialize dot matrix display driver, marks the whole panel dirty
+  error = gui_display_init();
+  if(error != SL_STATUS_OK)
+  {
+      return error;
+  }
 
   // get glib handle
   GLIB_contextInit(&glib_context);
@@ -78,328 +118,432 @@ static void display_init(void)
   // set font
   glib_context.font             = GLIB_FontNarrow6x8;
 
+  // text is blitted a word at a time from masks of the GLIB glyphs, a font
+  // that doesn't fit the blit is drawn by GLIB
+  gui_display_capture_font(glib_context.font.fontWidth, glib_context.font.fontHeight, render_glyph);
+
   // clear display
-  GLIB_clear(&glib_context);
+  gui_display_fill_rect(0, 0, GUI_DISPLAY_WIDTH - 1, GUI_DISPLAY_HEIGHT - 1, GUI_DISPLAY_WHITE);
 
-  // mark display update needed
-  update_display = true;
+  return SL_STATUS_OK;
 }
 
-static void draw_button(const button_t* button, bool pressed)
+static void render_glyph(char c, int32_t x, int32_t y)
 {
-  int32_t char_x, char_y;
+  GLIB_drawChar(&glib_context, c, x, y, false);
+}
+
+// foreground glyph over what is there, like GLIB_drawChar without opaque
+static void draw_glyph(char c, int32_t x, int32_t y)
+{
+  if(gui_display_draw_glyph(c, x, y, GUI_DISPLAY_BLACK) != SL_STATUS_OK)
+  {
+      render_glyph(c, x, y);
+  }
+}
 
-  // only modify button area
-  GLIB_setClippingRegion(&glib_context, &button->rect);
+// place a text field where GLIB_drawStringOnLine would put the line
+static void text_field_init(text_field_t* field, int32_t x, uint8_t line, int32_t y_offset)
+{
+  field->x = x;
+  field->y = y_offset + line * (glib_context.font.fontHeight + glib_context.font.lineSpacing);
+
+  // the background under the field is blank
+  memset(field->text, ' ', TEXT_FIELD_LEN);
+  field->text[TEXT_FIELD_LEN] = '\0';
+}
 
-  // clear button area
-  GLIB_clearRegion(&glib_context);
+// diff against what is on screen and redraw only the glyph cells that changed,
+// only the field rows are marked dirty and only when something changed
+static void text_field_set(text_field_t* field, const char* text)
+{
+  int32_t pitch = glib_context.font.fontWidth + glib_context.font.charSpacing;
+  bool    ended = false;
+  char    glyph;
 
-  GLIB_resetClippingRegion(&glib_context);
-  GLIB_resetDisplayClippingArea(&glib_context);
+  for(uint32_t i = 0; i < TEXT_FIELD_LEN; i++)
+  {
+      // pad with spaces past the end of the new text
+      ended = ended || (text[i] == '\0');
+      glyph = ended ? ' ' : text[i];
 
-  // we want to center text in button
-  // drawChar expects (x,y) of upper left corner
-  // find the center of area then offset by half font width & height
-  char_x = (button->rect.xMax + button->rect.xMin) / 2;
-  char_x -= glib_context.font.fontWidth / 2;
+      if(glyph == field->text[i])
+      {
+          continue;
+      }
 
-  char_y = (button->rect.yMax + button->rect.yMin) / 2;
-  char_y -= glib_context.font.fontHeight / 2;
-  char_y += 2;
+      gui_display_restore_background(field->x + (i * pitch), field->y,
+                                     field->x + ((i + 1) * pitch) - 1,
+                                     field->y + glib_context.font.fontHeight - 1);
 
-  if(pressed) {
-      // dark button looks like it's pressed :)
-      GLIB_drawRectFilled(&glib_context, &button->rect);
-      // set color to contrast dark background
-      glib_context.foregroundColor = White;
-  } else {
-      // draw outlined box
-      GLIB_drawRect(&glib_context, &button->rect);
+      if(glyph != ' ')
+      {
+          draw_glyph(glyph, field->x + (i * pitch), field->y);
+      }
+
+      field->text[i] = glyph;
   }
+}
+
+// we want to center text in button
+// drawChar expects (x,y) of upper left corner
+// find the center of area then offset by half font width & height
+static void button_char_position(const button_t* button, int32_t* char_x, int32_t* char_y)
+{
+  *char_x  = (button->rect.xMax + button->rect.xMin) / 2;
+  *char_x -= glib_context.font.fontWidth / 2;
+
+  *char_y  = (button->rect.yMax + button->rect.yMin) / 2;
+  *char_y -= glib_context.font.fontHeight / 2;
+  *char_y += 2;
+}
 
+// released button, part of the static background
+static void draw_button_chrome(const button_t* button)
+{
+  int32_t char_x, char_y;
+
+  button_char_position(button, &char_x, &char_y);
+
+  // draw outlined box
+  GLIB_drawRect(&glib_context, &button->rect);
   GLIB_drawChar(&glib_context, button->name, char_x, char_y, false);
-  glib_context.foregroundColor = Black;
+}
 
-  // mark display update needed
-  update_display = true;
+static void draw_button(const button_t* button, bool pressed)
+{
+  // the background holds the released button, marks the button rows dirty
+  gui_display_restore_background(button->rect.xMin, button->rect.yMin,
+                                 button->rect.xMax, button->rect.yMax);
+
+  if(pressed) {
+      // dark button looks like it's pressed :), inverting the inside of the
+      // outline turns the char white on black without redrawing it
+      gui_display_invert_rect(button->rect.xMin + 1, button->rect.yMin + 1,
+                              button->rect.xMax - 1, button->rect.yMax - 1);
+  }
 }
 
-void gui_init(void)
+sl_status_t gui_init(void)
 {
-  log_index = 0;
+  sl_status_t error;
+
+  log_count   = 0;
+  frame_ready = true;
 
   // initialize event queue
   gui_event_queue_init();
 
-  // initialize GLIB handler
-  display_init();
+  // initialize GLIB handler, without a display the events are still taken
+  // and dropped so producers never notice
+  error = display_init();
+  if(error != SL_STATUS_OK)
+  {
+      return error;
+  }
 
   // title header
   GLIB_drawStringOnLine(&glib_context, TITLE_STR, TITLE_LINE, GLIB_ALIGN_CENTER,
                         TITLE_OFFSET_X, TITLE_OFFSET_Y, false);
 
   // title divider
-  GLIB_drawLineH(&glib_context, 0,  9, 127);
-  GLIB_drawLineH(&glib_context, 0, 11, 127);
+  gui_display_fill_rect(0, 9, 127, 9, GUI_DISPLAY_BLACK);
+  gui_display_fill_rect(0, 11, 127, 11, GUI_DISPLAY_BLACK);
 
   // log divider
-  GLIB_drawLineH(&glib_context, 0, 54, 127);
+  gui_display_fill_rect(0, 54, 127, 54, GUI_DISPLAY_BLACK);
 
   // IP addr divider
-  GLIB_drawLineH(&glib_context, 0,  99, 127);
-  GLIB_drawLineH(&glib_context, 0, 101, 127);
+  gui_display_fill_rect(0, 99, 127, 99, GUI_DISPLAY_BLACK);
+  gui_display_fill_rect(0, 101, 127, 101, GUI_DISPLAY_BLACK);
 
   // button divider
-  GLIB_drawLineH(&glib_context, 0, 111, 127);
+  gui_display_fill_rect(0, 111, 127, 111, GUI_DISPLAY_BLACK);
+
+  draw_button_chrome(&button_left);
+  draw_button_chrome(&button_right);
+
+  // everything drawn so far is static, widgets redraw on top of a copy of it
+  gui_display_capture_background();
 
-  draw_button(&button_left,  false);
-  draw_button(&button_right, false);
+  // pressed and released buttons go out ahead of any other rows
+  gui_display_set_priority_rows(button_left.rect.yMin, button_left.rect.yMax);
+
+  text_field_init(&network_name_field,    THREAD_INFO_OFFSET_X, THREAD_INFO_LINE,     THREAD_INFO_OFFSET_Y);
+  text_field_init(&network_channel_field, THREAD_INFO_OFFSET_X, THREAD_INFO_LINE + 1, THREAD_INFO_OFFSET_Y);
+  text_field_init(&device_role_field,     THREAD_INFO_OFFSET_X, THREAD_INFO_LINE + 2, THREAD_INFO_OFFSET_Y);
+
+  // the address always has the same length, center it once
+  text_field_init(&mac_addr_field,
+                  ADDR_OFFSET_X + (GUI_DISPLAY_WIDTH - MAC_ADDR_STR_LEN * (glib_context.font.fontWidth + glib_context.font.charSpacing)) / 2,
+                  ADDR_LINE, ADDR_OFFSET_Y);
 
   // mark display update needed
-  update_display = true;
+  gui_display_mark_dirty(0, GUI_DISPLAY_HEIGHT - 1);
+
+  return SL_STATUS_OK;
+}
+
+static void gui_render_log(gui_log_id_t id, uint16_t arg, const char* text)
+{
+  char line[GUI_LOG_RENDER_LEN];
+
+  if(id >= GUI_LOG_COUNT)
+  {
+      return;
+  }
+
+  switch(id) {
+    case GUI_LOG_JOINER_ERROR:
+      snprintf(line, sizeof(line), gui_log_strings[id], text);
+      break;
+
+    case GUI_LOG_COAP_TX:
+      snprintf(line, sizeof(line), gui_log_strings[id], (char) arg);
+      break;
+
+    case GUI_LOG_COAP_LOST:
+      snprintf(line, sizeof(line), gui_log_strings[id], (unsigned) arg);
+      break;
+
+    default:
+      // no arguments, print as is
+      gui_print_log(gui_log_strings[id]);
+      return;
+  }
+
+  gui_print_log(line);
 }
 
-void gui_update(void)
+static void gui_render_event(const gui_event_t* event)
 {
-  sl_status_t status;
-  gui_event_t event;
+  char temp[MAC_ADDR_STR_LEN + 1];
+  char ch[4];   // "%u" of a uint8_t
+
+  REMOTE_LOG_DEBUG(REMOTE_LOG_GUI_EVENT, event->flag);
+
+  switch(event->flag) {
+    case GUI_EVENT_FLAG_BTN0_PRESSED:
+      draw_button(&button_right, true);
+      break;
+
+    case GUI_EVENT_FLAG_BTN0_RELEASED:
+      draw_button(&button_right, false);
+      break;
+
+    case GUI_EVENT_FLAG_BTN1_PRESSED:
+      draw_button(&button_left, true);
+      break;
+
+    case GUI_EVENT_FLAG_BTN1_RELEASED:
+      draw_button(&button_left, false);
+      break;
+
+    case GUI_EVENT_FLAG_NTWK_NAME:
+      gui_print_network_name(event->text);
+      break;
+
+    case GUI_EVENT_FLAG_NTWK_CH:
+      snprintf(ch, sizeof(ch), "%u", event->channel);
+      gui_print_network_channel(ch);
+      break;
+
+    case GUI_EVENT_FLAG_NTWK_ADDR:
+      snprintf(temp, sizeof(temp), "%02X:%02X:%02X:%02X:%02X:%02X",
+               event->eui64[0], event->eui64[1], event->eui64[2],
+               event->eui64[5], event->eui64[6], event->eui64[7]);
+      gui_print_mac_addr(temp);
+      break;
+
+    case GUI_EVENT_FLAG_NTWK_ROLE:
+      gui_print_device_role(event->text);
+      break;
+
+    case GUI_EVENT_FLAG_LOG:
+      gui_render_log(event->log.id, event->log.arg, event->log.text);
+      break;
+
+    default:
+      break;
+  }
+}
 
-  // read events from the queue
-  do {
-      status = ring_buffer_get(&gui_event_queue, &event);
+// render up to budget events from a lane straight from the queue, returns
+// the number rendered
+static uint32_t gui_drain_lane(gui_event_lane_t lane, uint32_t budget)
+{
+  gui_event_t* event;
+  uint32_t     rendered = 0;
 
-      if(status != SL_STATUS_OK)
+  for(; rendered < budget; rendered++)
+  {
+      if(gui_event_queue_peek(lane, &event) != SL_STATUS_OK)
       {
           break;
       }
 
-      printf("\tflag: %u, msg: %s\r\n", event.flag, event.msg);
+      gui_render_event(event);
 
-      switch(event.flag) {
-        case GUI_EVENT_FLAG_BTN0_PRESSED:
-          draw_button(&button_right, true);
-          break;
+      // done with the slot, hand it back to the producers
+      gui_event_queue_release(lane);
+  }
 
-        case GUI_EVENT_FLAG_BTN0_RELEASED:
-          draw_button(&button_right, false);
-          break;
+  return rendered;
+}
 
-        case GUI_EVENT_FLAG_BTN1_PRESSED:
-          draw_button(&button_left, true);
-          break;
+void gui_frame_tick(void)
+{
+  frame_ready = true;
+}
 
-        case GUI_EVENT_FLAG_BTN1_RELEASED:
-          draw_button(&button_left, false);
-          break;
+bool gui_update(void)
+{
+  bool flush_now;
+  bool flushed = false;
 
-        case GUI_EVENT_FLAG_NTWK_NAME:
-          gui_print_network_name((char *)&event.msg);
-          break;
+  // input and state first, all of it. button feedback skips the frame cap
+  flush_now = gui_drain_lane(GUI_EVENT_LANE_INPUT, UINT32_MAX) > 0;
+  gui_drain_lane(GUI_EVENT_LANE_STATE, UINT32_MAX);
 
-        case GUI_EVENT_FLAG_NTWK_CH:
-          gui_print_network_channel((char *)&event.msg);
-          break;
+  // log lines are limited per update so a burst can't stall the loop
+  gui_drain_lane(GUI_EVENT_LANE_LOG, LOG_EVENTS_PER_UPDATE);
 
-        case GUI_EVENT_FLAG_NTWK_ADDR:
-          gui_print_mac_addr((char *)&event.msg);
-          break;
+  // everything rendered until the next frame tick piles up in the dirty rows
+  // and goes out as one flush
+  if((frame_ready || flush_now) && gui_display_is_dirty())
+  {
+      frame_ready = false;
 
-        case GUI_EVENT_FLAG_NTWK_ROLE:
-          gui_print_device_role((char *)&event.msg);
-          break;
+      // only send the rows that changed, the transfer is spread over the
+      // following passes so the OpenThread tasklets aren't held up by the LCD
+      flushed = (gui_display_flush_start(NULL) == SL_STATUS_OK);
+  }
 
-        case GUI_EVENT_FLAG_LOG:
-          gui_print_log((char *)&event.msg);
-          break;
+  gui_display_process();
 
-        default:
-          break;
-      }
+  return flushed;
+}
+
+bool gui_is_busy(void)
+{
+  gui_event_queue_stats_t stats;
 
-  } while (status == SL_STATUS_OK);
+  if(gui_display_is_busy() || (frame_ready && gui_display_is_dirty()))
+  {
+      return true;
+  }
 
-  // only update when needed
-  if(update_display)
+  for(gui_event_lane_t lane = 0; lane < GUI_EVENT_LANE_COUNT; lane++)
   {
-      DMD_updateDisplay();
-      update_display = false;
+      if((gui_event_queue_get_stats(lane, &stats) == SL_STATUS_OK) && (stats.depth > 0))
+      {
+          return true;
+      }
   }
+
+  return false;
 }
 
-void gui_button_handler(const sl_button_t *handle)
+static void gui_button_event(uint32_t flag)
 {
-  gui_event_t event = {
-      .flag = 0,
-      .msg  = {0},
-  };
+  // button events carry no payload
+  gui_event_t event = { .flag = flag };
 
-  if (sl_button_get_state(handle) == SL_SIMPLE_BUTTON_PRESSED) {
-    if (&sl_button_btn0 == handle) {
-        event.flag = GUI_EVENT_FLAG_BTN0_PRESSED;
-        ring_buffer_add(&gui_event_queue, &event);
-    }
+  gui_event_queue_add(&event);
+}
 
-    if (&sl_button_btn1 == handle) {
-        event.flag = GUI_EVENT_FLAG_BTN1_PRESSED;
-        ring_buffer_add(&gui_event_queue, &event);
-    }
-  }
-  else if (sl_button_get_state(handle) == SL_SIMPLE_BUTTON_RELEASED) {
-    if (&sl_button_btn0 == handle) {
-        event.flag = GUI_EVENT_FLAG_BTN0_RELEASED;
-        ring_buffer_add(&gui_event_queue, &event);
-    }
-
-    if (&sl_button_btn1 == handle) {
-        event.flag = GUI_EVENT_FLAG_BTN1_RELEASED;
-        ring_buffer_add(&gui_event_queue, &event);
-    }
+void gui_button_handler(uint8_t button, bool pressed)
+{
+  static const uint32_t flags[2][2] = {
+      { GUI_EVENT_FLAG_BTN0_RELEASED, GUI_EVENT_FLAG_BTN0_PRESSED },
+      { GUI_EVENT_FLAG_BTN1_RELEASED, GUI_EVENT_FLAG_BTN1_PRESSED },
+  };
+
+  if(button < 2)
+  {
+      gui_button_event(flags[button][pressed ? 1 : 0]);
   }
 }
 
-void gui_print_log(char *string)
+void gui_print_log(const char *string)
 {
-  uint8_t temp_ind;
+  int32_t           pitch       = glib_context.font.fontHeight + glib_context.font.lineSpacing;
+  int32_t           glyph_pitch = glib_context.font.fontWidth + glib_context.font.charSpacing;
+  int32_t           y_top       = LOG_OFFSET_Y + (LOG_LINE * pitch);
+  int32_t           y_bottom    = y_top + ((LOG_VISIBLE_LINES - 1) * pitch) + glib_context.font.fontHeight - 1;
+  GLIB_Rectangle_t  new_line    = {log_window.xMin, y_bottom - pitch + 1, log_window.xMax, y_bottom};
+  char*             line        = log_buffer[log_count % LOG_BUFFER_LEN];
 
-  // add entry to log buffer
-  strncpy((char *)&log_buffer[log_index], string, DISPLAY_LOG_MAX_STR_LEN);
+  // add entry to the scrollback, the visible lines are moved in the
+  // framebuffer and never redrawn from it
+  strncpy(line, string, DISPLAY_LOG_MAX_STR_LEN);
 
   if(strlen(string) > DISPLAY_LOG_MAX_STR_LEN)
   {
       // mark last as null
       // mark second to last as asterisk
-      log_buffer[log_index][DISPLAY_LOG_MAX_STR_LEN - 1] = '*';
+      line[DISPLAY_LOG_MAX_STR_LEN - 1] = '*';
   }
 
   // mark last char as empty in the case that string is longer than DISPLAY_LOG_MAX_STR_LEN
-  log_buffer[log_index][DISPLAY_LOG_MAX_STR_LEN] = '\0';
+  line[DISPLAY_LOG_MAX_STR_LEN] = '\0';
 
-  // clear log area
-  GLIB_setClippingRegion(&glib_context, &log_window);
-  GLIB_clearRegion(&glib_context);
+  // scroll the rendered lines up by one, marks the log rows dirty
+  gui_display_scroll_up(y_top, y_bottom, pitch);
 
-  GLIB_resetClippingRegion(&glib_context);
-  GLIB_resetDisplayClippingArea(&glib_context);
+  // clear the bottom line
+  gui_display_restore_background(new_line.xMin, new_line.yMin, new_line.xMax, new_line.yMax);
 
-  // reverse print the log buffer to the display
-  temp_ind = log_index;
-  for(int8_t x = LOG_BUFFER_LEN - 1; x >= 0; x--)
+  // only the new entry gets rasterized, where GLIB_drawStringOnLine would
+  // put the last visible line
+  for(uint32_t i = 0; line[i] != '\0'; i++)
   {
-      GLIB_drawStringOnLine(&glib_context, (const char*) &log_buffer[temp_ind],
-                            LOG_LINE + x, GLIB_ALIGN_LEFT,
-                            LOG_OFFSET_X, LOG_OFFSET_Y,
-                            false);
-
-      temp_ind = (temp_ind == 0) ? 3 : temp_ind - 1;
+      draw_glyph(line[i], LOG_OFFSET_X + (i * glyph_pitch), y_bottom - glib_context.font.fontHeight + 1);
   }
 
-  // increment and loop around log index
-  log_index = (log_index + 1) % LOG_BUFFER_LEN;
-
-  // mark display update needed
-  update_display = true;
+  log_count++;
 }
 
-void gui_print_network_name(char *string)
+const char* gui_get_log_line(uint32_t age)
 {
-  char temp[20];
+  if((age >= LOG_BUFFER_LEN) || (age >= log_count))
+  {
+      return NULL;
+  }
 
-  // blank line
-  memset(&temp, ' ', 20);
-  temp[19] = '\0';
+  return log_buffer[(log_count - 1 - age) % LOG_BUFFER_LEN];
+}
 
-  GLIB_drawStringOnLine(&glib_context, temp,
-                            THREAD_INFO_LINE, GLIB_ALIGN_LEFT,
-                            THREAD_INFO_OFFSET_X, THREAD_INFO_OFFSET_Y,
-                            true);
+void gui_print_network_name(const char *string)
+{
+  char temp[TEXT_FIELD_LEN + 1];
 
   // print network name
-  snprintf((char *)&temp, 20, "name:  %s", string);
-  temp[19] = '\0';
-
-  GLIB_drawStringOnLine(&glib_context, temp,
-                          THREAD_INFO_LINE, GLIB_ALIGN_LEFT,
-                          THREAD_INFO_OFFSET_X, THREAD_INFO_OFFSET_Y,
-                          false);
-
-  // mark display update needed
-  update_display = true;
+  snprintf(temp, sizeof(temp), "name:  %s", string);
+  text_field_set(&network_name_field, temp);
 }
 
-void gui_print_network_channel(char *ch)
+void gui_print_network_channel(const char *ch)
 {
-  char temp[20];
-
-  // blank line
-  memset(&temp, ' ', 20);
-  temp[19] = '\0';
-
-  GLIB_drawStringOnLine(&glib_context, temp,
-                            THREAD_INFO_LINE + 1, GLIB_ALIGN_LEFT,
-                            THREAD_INFO_OFFSET_X, THREAD_INFO_OFFSET_Y,
-                            true);
+  char temp[TEXT_FIELD_LEN + 1];
 
   // print thread channel
-  snprintf((char *)&temp, 20, "ch:    %s", ch);
-  temp[19] = '\0';
-
-  GLIB_drawStringOnLine(&glib_context, temp,
-                          THREAD_INFO_LINE + 1, GLIB_ALIGN_LEFT,
-                          THREAD_INFO_OFFSET_X, THREAD_INFO_OFFSET_Y,
-                          false);
-
-  // mark display update needed
-  update_display = true;
+  snprintf(temp, sizeof(temp), "ch:    %s", ch);
+  text_field_set(&network_channel_field, temp);
 }
 
-void gui_print_device_role(char *string)
+void gui_print_device_role(const char *string)
 {
-  char temp[20];
-
-  // blank line
-  memset(&temp, ' ', 20);
-  temp[19] = '\0';
-
-  GLIB_drawStringOnLine(&glib_context, temp,
-                            THREAD_INFO_LINE + 2, GLIB_ALIGN_LEFT,
-                            THREAD_INFO_OFFSET_X, THREAD_INFO_OFFSET_Y,
-                            true);
+  char temp[TEXT_FIELD_LEN + 1];
 
   // print device state
-  snprintf((char *)&temp, 20, "state: %s", string);
-  temp[19] = '\0';
-
-  GLIB_drawStringOnLine(&glib_context, temp,
-                          THREAD_INFO_LINE + 2, GLIB_ALIGN_LEFT,
-                          THREAD_INFO_OFFSET_X, THREAD_INFO_OFFSET_Y,
-                          false);
-
-  // mark display update needed
-  update_display = true;
+  snprintf(temp, sizeof(temp), "state: %s", string);
+  text_field_set(&device_role_field, temp);
 }
 
-void gui_print_mac_addr(char *mac_addr)
+void gui_print_mac_addr(const char *mac_addr)
 {
-  char temp[20];
-
-  // blank line
-  memset(&temp, ' ', 20);
-  temp[19] = '\0';
-
-  GLIB_drawStringOnLine(&glib_context, temp,
-                          ADDR_LINE, GLIB_ALIGN_CENTER,
-                          ADDR_OFFSET_X, ADDR_OFFSET_Y,
-                          true);
-
   // print mac address
-  GLIB_drawStringOnLine(&glib_context, mac_addr,
-                          ADDR_LINE, GLIB_ALIGN_CENTER,
-                          ADDR_OFFSET_X, ADDR_OFFSET_Y,
-                          false);
-
-  // mark display update needed
-  update_display = true;
+  text_field_set(&mac_addr_field, mac_addr);
 }
 
-
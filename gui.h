@@ -49,13 +49,45 @@
 #define LOG_LINE                  6
 #define LOG_OFFSET_X              2
 #define LOG_OFFSET_Y              0
-#define LOG_BUFFER_LEN            4
+#define LOG_EVENTS_PER_UPDATE     1
+
+// rows between the log divider and the address divider
+#define LOG_WINDOW_Y_MIN          55
+#define LOG_WINDOW_Y_MAX          98
+
+// metrics of GLIB_FontNarrow6x8, for the layout checks at compile time
+#define GUI_FONT_HEIGHT           8
+#define GUI_FONT_LINE_SPACING     2
+#define GUI_FONT_LINE_PITCH       (GUI_FONT_HEIGHT + GUI_FONT_LINE_SPACING)
+
+// lines of the log window, the scroll band must end above LOG_WINDOW_Y_MAX
+#define LOG_MAX_VISIBLE_LINES     ((LOG_WINDOW_Y_MAX + 1 + GUI_FONT_LINE_SPACING - \
+                                    (LOG_OFFSET_Y + (LOG_LINE * GUI_FONT_LINE_PITCH))) / GUI_FONT_LINE_PITCH)
+#ifndef LOG_VISIBLE_LINES
+#define LOG_VISIBLE_LINES         LOG_MAX_VISIBLE_LINES
+#endif
+
+// scrollback depth, the last LOG_BUFFER_LEN lines are kept as text,
+// LOG_VISIBLE_LINES..16
+#ifndef LOG_BUFFER_LEN
+#define LOG_BUFFER_LEN            8
+#endif
 
 #define ADDR_LINE                 10
 #define ADDR_OFFSET_X             0
 #define ADDR_OFFSET_Y             3
 
+// minimum time between display flushes, updates in between are merged into
+// one flush. button feedback is flushed right away
+#ifndef GUI_FRAME_INTERVAL_MS
+#define GUI_FRAME_INTERVAL_MS     100
+#endif
+
+#define TEXT_FIELD_LEN            19
+#define MAC_ADDR_STR_LEN          17
+
 #define DISPLAY_LOG_MAX_STR_LEN   21
+#define GUI_LOG_RENDER_LEN        32
 
 #define GUI_EVENT_BUTTON_0        (1 << 0)
 #define GUI_EVENT_BUTTON_1        (1 << 1)
@@ -64,28 +96,53 @@
 #define GUI_EVENT_DEVICE_ROLE     (1 << 4)
 #define GUI_EVENT_LOG_MSG         (1 << 5)
 
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sl_status.h"
 #include "glib.h"
-#include "sl_button.h"
 
 typedef struct {
   GLIB_Rectangle_t  rect;
   char              name;
 } button_t;
 
+// retained text line, remembers what is on screen so only changed glyphs
+// get redrawn
+typedef struct {
+  int32_t           x;                        // left edge of the first glyph cell
+  int32_t           y;                        // top row of the glyphs
+  char              text[TEXT_FIELD_LEN + 1]; // rendered text, space padded
+} text_field_t;
+
 typedef struct {
   uint32_t          event;
   char              info[32];
 } event_t;
 
 
-void gui_init(void);
-void gui_update(void);
-void gui_button_handler(const sl_button_t *handle);
-void gui_print_log(char *string);
-void gui_print_network_name(char *string);
-void gui_print_network_channel(char *ch);
-void gui_print_device_role(char *string);
-void gui_print_mac_addr(char *mac_str);
+// the display errors of gui_display_init, the GUI then keeps taking events
+// but shows nothing
+sl_status_t gui_init(void);
+// renders the queued events, returns true when a flush was started. the
+// caller then runs a GUI_FRAME_INTERVAL_MS timer that calls gui_frame_tick,
+// nothing but button feedback is flushed before that. the timer only runs
+// after a flush so an idle GUI doesn't wake the device
+bool gui_update(void);
+// gui_update has work left for the next pass: a flush in progress, queued
+// events or a frame tick with rows to send. the main loop doesn't sleep then
+bool gui_is_busy(void);
+// the frame interval passed, safe from interrupt context
+void gui_frame_tick(void);
+// button 0 is the right ('B') button, button 1 the left ('A') one
+void gui_button_handler(uint8_t button, bool pressed);
+void gui_print_log(const char *string);
+// scrollback, age 0 is the newest log line. NULL past the lines kept
+const char* gui_get_log_line(uint32_t age);
+void gui_print_network_name(const char *string);
+void gui_print_network_channel(const char *ch);
+void gui_print_device_role(const char *string);
+void gui_print_mac_addr(const char *mac_str);
 
 
 #endif /* GUI_H_ */
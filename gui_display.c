@@ -0,0 +1,627 @@
+/***************************************************************************//**
+ * @file
+ * @brief GUI Display Driver
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <string.h>
+
+#include "dmd.h"
+#include "sl_memlcd.h"
+
+#include "gui_display.h"
+
+#define DIRTY_WORDS   ((GUI_DISPLAY_HEIGHT + 31) / 32)
+
+typedef enum {
+  RASTER_COPY,      // background to framebuffer
+  RASTER_SET,
+  RASTER_CLEAR,
+  RASTER_INVERT,
+} raster_op_t;
+
+static  uint8_t*              framebuffer;
+static  uint32_t              row_stride;                // bytes from one framebuffer row to the next
+static  uint32_t              background[GUI_DISPLAY_HEIGHT * GUI_DISPLAY_ROW_WORDS];
+static  uint32_t              dirty_rows[DIRTY_WORDS];   // changed since the last flush started
+static  gui_display_stats_t   stats;
+
+static  uint32_t              priority_rows[DIRTY_WORDS];  // sent first by every process call
+
+// row masks of the captured font, bit n of a row is the pixel at x + n
+static  uint8_t               glyphs[GUI_DISPLAY_GLYPH_LAST - GUI_DISPLAY_GLYPH_FIRST + 1][GUI_DISPLAY_GLYPH_MAX];
+static  uint32_t              glyph_width;
+static  uint32_t              glyph_height;              // 0 until a font is captured
+static  uint32_t              flush_rows[DIRTY_WORDS];   // still to be sent by the flush in progress
+static  uint32_t              flush_next;                // row the round robin scan resumes from
+static  bool                  flush_busy;
+static  gui_display_flush_callback_t flush_callback;
+
+static inline bool row_is_pending(uint32_t row)
+{
+  return (flush_rows[row / 32] & (1u << (row % 32))) != 0;
+}
+
+static inline bool row_is_priority(uint32_t row)
+{
+  return (priority_rows[row / 32] & (1u << (row % 32))) != 0;
+}
+
+sl_status_t gui_display_init(void)
+{
+  const sl_memlcd_t*    memlcd;
+  DMD_DisplayGeometry*  geometry;
+  uint8_t*              buffer;
+
+  // nothing is drawn or flushed unless init goes through
+  framebuffer   = NULL;
+  glyph_height  = 0;
+  flush_busy    = false;
+  flush_next  = 0;
+  memset(dirty_rows, 0, sizeof(dirty_rows));
+  memset(flush_rows, 0, sizeof(flush_rows));
+
+  // initialize dot matrix display driver, takes a framebuffer from the pool
+  if(DMD_init(0) != DMD_OK)
+  {
+      return SL_STATUS_INITIALIZATION;
+  }
+
+  if(DMD_getDisplayGeometry(&geometry) != DMD_OK)
+  {
+      return SL_STATUS_INITIALIZATION;
+  }
+
+  // the layout and the word-wise rasters are fixed to the panel size
+  memlcd = sl_memlcd_get();
+  if((memlcd == NULL) || (memlcd->bpp != 1) ||
+     (geometry->xSize != GUI_DISPLAY_WIDTH) || (geometry->ySize != GUI_DISPLAY_HEIGHT))
+  {
+      return SL_STATUS_INVALID_CONFIGURATION;
+  }
+
+  // sl_memlcd_draw walks the rows with the panel width as stride
+  row_stride = ((uint32_t) memlcd->width * memlcd->bpp) / 8;
+  if((row_stride < GUI_DISPLAY_ROW_BYTES) || ((row_stride % 4) != 0))
+  {
+      return SL_STATUS_INVALID_CONFIGURATION;
+  }
+
+  // own the framebuffer so rows can be sent to the memory LCD individually,
+  // the pool must hold one besides the one DMD_init took
+  if(DMD_allocateFramebuffer((void **) &buffer) != DMD_OK)
+  {
+      return SL_STATUS_ALLOCATION_FAILED;
+  }
+
+  if(DMD_selectFramebuffer(buffer) != DMD_OK)
+  {
+      return SL_STATUS_INITIALIZATION;
+  }
+
+  framebuffer = buffer;
+
+  memset(&stats, 0, sizeof(stats));
+
+  // content of the panel is unknown, send everything on the first flush
+  gui_display_mark_dirty(0, GUI_DISPLAY_HEIGHT - 1);
+
+  return SL_STATUS_OK;
+}
+
+void gui_display_mark_dirty(int32_t y_min, int32_t y_max)
+{
+  // clip to the panel
+  if(y_min < 0)
+  {
+      y_min = 0;
+  }
+
+  if(y_max > (GUI_DISPLAY_HEIGHT - 1))
+  {
+      y_max = GUI_DISPLAY_HEIGHT - 1;
+  }
+
+  for(int32_t row = y_min; row <= y_max; row++)
+  {
+      dirty_rows[row / 32] |= (1u << (row % 32));
+  }
+}
+
+bool gui_display_is_dirty(void)
+{
+  for(uint32_t i = 0; i < DIRTY_WORDS; i++)
+  {
+      if(dirty_rows[i])
+      {
+          return true;
+      }
+  }
+
+  return false;
+}
+
+sl_status_t gui_display_capture_background(void)
+{
+  if(framebuffer == NULL)
+  {
+      return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  for(uint32_t row = 0; row < GUI_DISPLAY_HEIGHT; row++)
+  {
+      memcpy(&background[row * GUI_DISPLAY_ROW_WORDS], &framebuffer[row * row_stride], GUI_DISPLAY_ROW_BYTES);
+  }
+
+  return SL_STATUS_OK;
+}
+
+// clip a rectangle to the panel, false when nothing is left
+static bool clip_rect(int32_t* x_min, int32_t* y_min, int32_t* x_max, int32_t* y_max)
+{
+  *x_min = (*x_min < 0) ? 0 : *x_min;
+  *y_min = (*y_min < 0) ? 0 : *y_min;
+  *x_max = (*x_max > (GUI_DISPLAY_WIDTH - 1))  ? (GUI_DISPLAY_WIDTH - 1)  : *x_max;
+  *y_max = (*y_max > (GUI_DISPLAY_HEIGHT - 1)) ? (GUI_DISPLAY_HEIGHT - 1) : *y_max;
+
+  return (*x_min <= *x_max) && (*y_min <= *y_max);
+}
+
+static inline uint32_t raster_word(raster_op_t op, uint32_t dst, uint32_t src)
+{
+  switch(op)
+  {
+    case RASTER_COPY:
+      return src;
+
+    case RASTER_SET:
+      return ~0u;
+
+    case RASTER_CLEAR:
+      return 0;
+
+    default:
+      return ~dst;
+  }
+}
+
+// apply op to x_min..x_max, y_min..y_max (inclusive) 32 pixels at a time,
+// RASTER_COPY takes its source from the background. marks the rows dirty
+static void raster_rect(raster_op_t op, int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max)
+{
+  uint32_t  first_word, last_word;
+  uint32_t  first_mask, last_mask;
+  uint32_t* dst;
+  uint32_t* src;
+
+  if((framebuffer == NULL) || !clip_rect(&x_min, &y_min, &x_max, &y_max))
+  {
+      return;
+  }
+
+  first_word  = x_min / 32;
+  last_word   = x_max / 32;
+  first_mask  = ~0u << (x_min % 32);
+  last_mask   = ~0u >> (31 - (x_max % 32));
+
+  if(first_word == last_word)
+  {
+      first_mask &= last_mask;
+  }
+
+  for(int32_t y = y_min; y <= y_max; y++)
+  {
+      dst = (uint32_t *) &framebuffer[y * row_stride];
+      src = &background[y * GUI_DISPLAY_ROW_WORDS];
+
+      // partial words at the edges keep the pixels outside the region
+      dst[first_word] = (dst[first_word] & ~first_mask)
+                      | (raster_word(op, dst[first_word], src[first_word]) & first_mask);
+
+      if(first_word == last_word)
+      {
+          continue;
+      }
+
+      for(uint32_t word = first_word + 1; word < last_word; word++)
+      {
+          dst[word] = raster_word(op, dst[word], src[word]);
+      }
+
+      dst[last_word] = (dst[last_word] & ~last_mask)
+                     | (raster_word(op, dst[last_word], src[last_word]) & last_mask);
+  }
+
+  gui_display_mark_dirty(y_min, y_max);
+}
+
+void gui_display_restore_background(int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max)
+{
+  raster_rect(RASTER_COPY, x_min, y_min, x_max, y_max);
+}
+
+void gui_display_fill_rect(int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max, gui_display_color_t color)
+{
+  raster_rect((color == GUI_DISPLAY_WHITE) ? RASTER_SET : RASTER_CLEAR, x_min, y_min, x_max, y_max);
+}
+
+void gui_display_invert_rect(int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max)
+{
+  raster_rect(RASTER_INVERT, x_min, y_min, x_max, y_max);
+}
+
+sl_status_t gui_display_capture_font(uint32_t width, uint32_t height, gui_display_glyph_renderer_t renderer)
+{
+  uint8_t* row;
+
+  if(framebuffer == NULL)
+  {
+      return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  if((renderer == NULL) || (width == 0) || (width > GUI_DISPLAY_GLYPH_MAX) ||
+     (height == 0) || (height > GUI_DISPLAY_GLYPH_MAX))
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  for(uint32_t c = GUI_DISPLAY_GLYPH_FIRST; c <= GUI_DISPLAY_GLYPH_LAST; c++)
+  {
+      raster_rect(RASTER_SET, 0, 0, GUI_DISPLAY_GLYPH_MAX - 1, height - 1);
+      renderer((char) c, 0, 0);
+
+      // the cell is within the first byte of each row, black pixels are clear
+      for(uint32_t y = 0; y < height; y++)
+      {
+          row = &framebuffer[y * row_stride];
+          glyphs[c - GUI_DISPLAY_GLYPH_FIRST][y] = (uint8_t) (~row[0] & ((1u << width) - 1));
+      }
+  }
+
+  raster_rect(RASTER_SET, 0, 0, GUI_DISPLAY_GLYPH_MAX - 1, height - 1);
+
+  glyph_width   = width;
+  glyph_height  = height;
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t gui_display_draw_glyph(char c, int32_t x, int32_t y, gui_display_color_t color)
+{
+  const uint8_t*  glyph;
+  uint32_t*       dst;
+  uint32_t        bits;
+  uint32_t        word;
+  uint32_t        shift;
+  bool            spill;
+  uint32_t        y_min, y_max;
+
+  if((framebuffer == NULL) || (glyph_height == 0))
+  {
+      return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  if(((uint8_t) c < GUI_DISPLAY_GLYPH_FIRST) || ((uint8_t) c > GUI_DISPLAY_GLYPH_LAST))
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  if((x <= -(int32_t) glyph_width) || (x >= GUI_DISPLAY_WIDTH) ||
+     (y <= -(int32_t) glyph_height) || (y >= GUI_DISPLAY_HEIGHT))
+  {
+      return SL_STATUS_OK;
+  }
+
+  glyph = glyphs[(uint8_t) c - GUI_DISPLAY_GLYPH_FIRST];
+  y_min = (y < 0) ? (uint32_t) -y : 0;
+  y_max = ((y + (int32_t) glyph_height) > GUI_DISPLAY_HEIGHT) ? (uint32_t) (GUI_DISPLAY_HEIGHT - y) : glyph_height;
+
+  for(uint32_t row = y_min; row < y_max; row++)
+  {
+      bits = glyph[row];
+
+      // clip at the panel edges, a row then never reaches past the last word
+      if(x < 0)
+      {
+          bits >>= -x;
+      }
+      else if((x + GUI_DISPLAY_GLYPH_MAX) > GUI_DISPLAY_WIDTH)
+      {
+          bits &= (1u << (GUI_DISPLAY_WIDTH - x)) - 1;
+      }
+
+      if(bits == 0)
+      {
+          continue;
+      }
+
+      stats.glyph_pixels += (uint32_t) __builtin_popcount(bits);
+
+      dst   = (uint32_t *) &framebuffer[(y + (int32_t) row) * row_stride];
+      word  = (x < 0) ? 0 : ((uint32_t) x / 32);
+      shift = (x < 0) ? 0 : ((uint32_t) x % 32);
+
+      // the part of the row past the word boundary goes into the next word
+      spill = ((shift + GUI_DISPLAY_GLYPH_MAX) > 32) && ((word + 1) < GUI_DISPLAY_ROW_WORDS);
+
+      if(color == GUI_DISPLAY_WHITE)
+      {
+          dst[word] |= bits << shift;
+          if(spill)
+          {
+              dst[word + 1] |= bits >> (32 - shift);
+          }
+      }
+      else
+      {
+          dst[word] &= ~(bits << shift);
+          if(spill)
+          {
+              dst[word + 1] &= ~(bits >> (32 - shift));
+          }
+      }
+  }
+
+  stats.glyphs++;
+  gui_display_mark_dirty(y + (int32_t) y_min, y + (int32_t) y_max - 1);
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t gui_display_scroll_up(int32_t y_min, int32_t y_max, uint32_t dy)
+{
+  if(framebuffer == NULL)
+  {
+      return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  if((y_min < 0) || (y_max >= GUI_DISPLAY_HEIGHT) || (y_min > y_max))
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  if(dy > (uint32_t) (y_max - y_min))
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  // rows are contiguous in the framebuffer, the whole band moves at once
+  memmove(&framebuffer[y_min * row_stride],
+          &framebuffer[(y_min + dy) * row_stride],
+          ((y_max - y_min + 1) - dy) * row_stride);
+
+  gui_display_mark_dirty(y_min, y_max);
+
+  return SL_STATUS_OK;
+}
+
+static bool flush_pending(void)
+{
+  for(uint32_t i = 0; i < DIRTY_WORDS; i++)
+  {
+      if(flush_rows[i])
+      {
+          return true;
+      }
+  }
+
+  return false;
+}
+
+sl_status_t gui_display_flush_start(gui_display_flush_callback_t callback)
+{
+  if(framebuffer == NULL)
+  {
+      return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  if(!gui_display_is_dirty())
+  {
+      return flush_busy ? SL_STATUS_IN_PROGRESS : SL_STATUS_EMPTY;
+  }
+
+  // move the dirty rows into the flush, drawing can go on marking new ones
+  for(uint32_t i = 0; i < DIRTY_WORDS; i++)
+  {
+      flush_rows[i] |= dirty_rows[i];
+      dirty_rows[i]  = 0;
+  }
+
+  if(flush_busy)
+  {
+      // the scan goes on from where it is, rows added behind it are reached
+      // after it wraps around
+      stats.superseded++;
+  }
+
+  flush_busy      = true;
+  flush_callback  = callback;
+
+  return SL_STATUS_OK;
+}
+
+void gui_display_set_priority_rows(int32_t y_min, int32_t y_max)
+{
+  memset(priority_rows, 0, sizeof(priority_rows));
+
+  y_min = (y_min < 0) ? 0 : y_min;
+  y_max = (y_max > (GUI_DISPLAY_HEIGHT - 1)) ? (GUI_DISPLAY_HEIGHT - 1) : y_max;
+
+  for(int32_t row = y_min; row <= y_max; row++)
+  {
+      priority_rows[row / 32] |= (1u << (row % 32));
+  }
+}
+
+// send rows first..first + count - 1 with one transfer, they stay pending
+// when the transfer fails
+static sl_status_t flush_run(const sl_memlcd_t* memlcd, uint32_t first, uint32_t count)
+{
+  sl_status_t error;
+
+  error = sl_memlcd_draw(memlcd, &framebuffer[first * row_stride], first, count);
+  if(error != SL_STATUS_OK)
+  {
+      return error;
+  }
+
+  for(uint32_t sent = first; sent < (first + count); sent++)
+  {
+      flush_rows[sent / 32] &= ~(1u << (sent % 32));
+  }
+
+  stats.rows  += count;
+  stats.bytes += count * (row_stride + GUI_DISPLAY_LINE_OVERHEAD);
+
+  return SL_STATUS_OK;
+}
+
+void gui_display_process(void)
+{
+  const sl_memlcd_t*  memlcd;
+  uint32_t            budget  = GUI_DISPLAY_ROWS_PER_PROCESS;
+  uint32_t            scanned = 0;
+  uint32_t            first;
+  uint32_t            row;
+
+  if(!flush_busy)
+  {
+      return;
+  }
+
+  memlcd = sl_memlcd_get();
+
+  // pending priority rows go out before anything else
+  for(row = 0; (row < GUI_DISPLAY_HEIGHT) && (budget > 0); )
+  {
+      if(!(flush_rows[row / 32] & priority_rows[row / 32]))
+      {
+          // nothing of interest in the rest of this word
+          row = (row + 32) & ~31u;
+          continue;
+      }
+
+      if(!row_is_pending(row) || !row_is_priority(row))
+      {
+          row++;
+          continue;
+      }
+
+      first = row;
+      while((row < GUI_DISPLAY_HEIGHT) && (budget > 0) && row_is_pending(row) && row_is_priority(row))
+      {
+          row++;
+          budget--;
+      }
+
+      if(flush_run(memlcd, first, row - first) != SL_STATUS_OK)
+      {
+          return;
+      }
+  }
+
+  // then round robin from the row the last call stopped at, at most one
+  // turn. a run of rows is cut at the bottom of the panel and goes on from
+  // row 0
+  row = flush_next;
+
+  while((scanned < GUI_DISPLAY_HEIGHT) && (budget > 0))
+  {
+      if(!row_is_pending(row))
+      {
+          row = (row + 1) % GUI_DISPLAY_HEIGHT;
+          scanned++;
+          continue;
+      }
+
+      // send the run of pending rows with a single transfer
+      first = row;
+      while((row < GUI_DISPLAY_HEIGHT) && (budget > 0) && row_is_pending(row))
+      {
+          row++;
+          scanned++;
+          budget--;
+      }
+
+      if(flush_run(memlcd, first, row - first) != SL_STATUS_OK)
+      {
+          // try again on the next call
+          flush_next = first;
+          return;
+      }
+
+      row %= GUI_DISPLAY_HEIGHT;
+  }
+
+  flush_next = row;
+
+  if(flush_pending())
+  {
+      return;
+  }
+
+  // every row went out
+  flush_busy = false;
+  stats.flushes++;
+
+  if(flush_callback != NULL)
+  {
+      flush_callback();
+  }
+}
+
+bool gui_display_is_busy(void)
+{
+  return flush_busy;
+}
+
+sl_status_t gui_display_get_stats(gui_display_stats_t* out)
+{
+  if(out == NULL)
+  {
+      return SL_STATUS_NULL_POINTER;
+  }
+
+  *out = stats;
+
+  return SL_STATUS_OK;
+}
+
+const uint8_t* gui_display_get_framebuffer(void)
+{
+  return framebuffer;
+}
+
+uint32_t gui_display_get_row_stride(void)
+{
+  return row_stride;
+}
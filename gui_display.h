@@ -0,0 +1,161 @@
+/***************************************************************************//**
+ * @file
+ * @brief GUI Display Driver Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef GUI_DISPLAY_H_
+#define GUI_DISPLAY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sl_status.h"
+
+#define GUI_DISPLAY_WIDTH         128
+#define GUI_DISPLAY_HEIGHT        128
+
+// 1 bpp framebuffer as laid out by the memory LCD DMD driver, pixel x of a
+// row is bit (x % 8) of byte (x / 8). on the little endian target that makes
+// it bit (x % 32) of 32-bit word (x / 32), which the word-wise copies rely on.
+// the distance between two rows comes from the driver at init, see
+// gui_display_get_row_stride
+#define GUI_DISPLAY_ROW_BYTES     (GUI_DISPLAY_WIDTH / 8)
+#define GUI_DISPLAY_ROW_WORDS     (GUI_DISPLAY_ROW_BYTES / 4)
+
+// pixel values, a set bit is a white pixel on the memory LCD
+typedef enum {
+  GUI_DISPLAY_BLACK = 0,
+  GUI_DISPLAY_WHITE = 1,
+} gui_display_color_t;
+
+// bytes the memory LCD needs per line on top of the pixels, address + dummy
+#define GUI_DISPLAY_LINE_OVERHEAD 2
+
+// rows sent per gui_display_process call, bounds the time the main loop
+// spends on the display before OpenThread tasklets get to run again
+#ifndef GUI_DISPLAY_ROWS_PER_PROCESS
+#define GUI_DISPLAY_ROWS_PER_PROCESS  16
+#endif
+
+// glyphs the word-wise blit holds, captured from the GUI font at init. a cell
+// is at most 8 x 8 pixels
+#define GUI_DISPLAY_GLYPH_FIRST   0x20
+#define GUI_DISPLAY_GLYPH_LAST    0x7e
+#define GUI_DISPLAY_GLYPH_MAX     8
+
+// draws glyph c with its top left corner at x, y into the framebuffer, the
+// glyph pixels black and the others left alone
+typedef void (*gui_display_glyph_renderer_t)(char c, int32_t x, int32_t y);
+
+// called from gui_display_process once every row of a flush has been sent
+typedef void (*gui_display_flush_callback_t)(void);
+
+typedef struct {
+  uint32_t  flushes;        // flushes completed
+  uint32_t  rows;           // rows transferred
+  uint32_t  bytes;          // bytes transferred, row strides and line overhead
+  uint32_t  superseded;     // flushes extended by a newer frame while in progress
+  uint32_t  glyphs;         // glyphs drawn by gui_display_draw_glyph
+  uint32_t  glyph_pixels;   // glyph pixels those wrote, after clipping
+} gui_display_stats_t;
+
+// initialize DMD and take a framebuffer of its own from the DMD pool.
+// SL_STATUS_INITIALIZATION when the driver fails, SL_STATUS_ALLOCATION_FAILED
+// when the pool has no framebuffer left besides the one DMD_init takes,
+// SL_STATUS_INVALID_CONFIGURATION when the panel is not a GUI_DISPLAY_WIDTH x
+// GUI_DISPLAY_HEIGHT 1 bpp one or its rows are not whole 32-bit words
+sl_status_t gui_display_init(void);
+
+// mark rows y_min..y_max (inclusive) as changed since the last flush
+void        gui_display_mark_dirty(int32_t y_min, int32_t y_max);
+bool        gui_display_is_dirty(void);
+
+// snapshot the current framebuffer as the static background (title, dividers,
+// button outlines), called once the chrome has been drawn at boot
+sl_status_t gui_display_capture_background(void);
+
+// copy the background back over x_min..x_max, y_min..y_max (inclusive) with
+// 32-bit word copies, marks the rows dirty
+void        gui_display_restore_background(int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max);
+
+// word-wise fill / invert of x_min..x_max, y_min..y_max (inclusive), a span is
+// a rectangle one row high. clipped to the panel, marks the rows dirty
+void        gui_display_fill_rect(int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max, gui_display_color_t color);
+void        gui_display_invert_rect(int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max);
+
+// render every glyph of the font once through renderer and keep its rows as
+// bit masks, width x height is the glyph cell. uses the top left cell of the
+// framebuffer as scratch and marks it dirty, so it is called before the GUI
+// draws anything. SL_STATUS_INVALID_PARAMETER when the cell is too large
+sl_status_t gui_display_capture_font(uint32_t width, uint32_t height, gui_display_glyph_renderer_t renderer);
+
+// draw glyph c with its top left corner at x, y in color, pixels outside the
+// glyph are left alone. a row goes in with one or two word writes, clipped to
+// the panel, marks the rows dirty. SL_STATUS_NOT_INITIALIZED before a font was
+// captured, SL_STATUS_INVALID_PARAMETER when c isn't in the captured range,
+// the caller draws the glyph some other way then
+sl_status_t gui_display_draw_glyph(char c, int32_t x, int32_t y, gui_display_color_t color);
+
+// move rows y_min + dy..y_max up by dy rows with a row copy, the dy rows left
+// at the bottom keep their old content for the caller to redraw. all rows
+// y_min..y_max are marked dirty
+sl_status_t gui_display_scroll_up(int32_t y_min, int32_t y_max, uint32_t dy);
+
+// start sending the dirty rows to the display and return right away, the rows
+// go out from gui_display_process. starting while a flush is in progress folds
+// the newer dirty rows into it without restarting the scan, rows are always
+// read from the live framebuffer so the panel ends up showing the latest
+// frame. returns SL_STATUS_EMPTY when there is nothing to send
+sl_status_t gui_display_flush_start(gui_display_flush_callback_t callback);
+
+// rows y_min..y_max (inclusive) are sent ahead of the round robin by every
+// gui_display_process call, for widgets whose feedback must not wait behind
+// a large redraw. replaces the previous band
+void        gui_display_set_priority_rows(int32_t y_min, int32_t y_max);
+
+// send the next rows of the flush in progress, contiguous rows go out as one
+// transfer. pending priority rows go first, the others are visited round
+// robin from where the previous call stopped, so rows dirtied over and over
+// can't starve the ones after them
+void        gui_display_process(void);
+bool        gui_display_is_busy(void);
+
+sl_status_t gui_display_get_stats(gui_display_stats_t* stats);
+
+// read-only view of the framebuffer, GUI_DISPLAY_HEIGHT rows
+// gui_display_get_row_stride bytes apart, for snapshots of what the panel
+// shows. NULL before a successful init
+const uint8_t* gui_display_get_framebuffer(void);
+uint32_t       gui_display_get_row_stride(void);
+
+#endif /* GUI_DISPLAY_H_ */
@@ -34,32 +34,387 @@
  * Silicon Labs may update projects from time to time.
  ******************************************************************************/
 
+#include <string.h>
+
+#include "remote_port.h"
+
 #include "ring_buffer.h"
 #include "gui_event_queue.h"
 
-#define EVENT_QUEUE_BUFFER_SIZE 16
+// flag plus 8 payload bytes on the 32-bit target, the host has wider pointers
+_Static_assert((sizeof(void*) > 4) || (sizeof(gui_event_t) == 12), "gui_event_t grew");
+
+#define EVENT_QUEUE_INPUT_BUFFER_SIZE   8
+#define EVENT_QUEUE_LOG_BUFFER_SIZE     16
+
+#ifndef EVENT_QUEUE_INPUT_OVERFLOW_POLICY
+#define EVENT_QUEUE_INPUT_OVERFLOW_POLICY GUI_EVENT_QUEUE_POLICY_COALESCE
+#endif
+
+#ifndef EVENT_QUEUE_LOG_OVERFLOW_POLICY
+#define EVENT_QUEUE_LOG_OVERFLOW_POLICY   GUI_EVENT_QUEUE_POLICY_OVERWRITE_OLDEST
+#endif
 
-static gui_event_t gui_events[EVENT_QUEUE_BUFFER_SIZE];
-static void*       buffer[EVENT_QUEUE_BUFFER_SIZE];
+// state fields, one slot each in the state lane
+typedef enum {
+  STATE_NTWK_NAME,
+  STATE_NTWK_CH,
+  STATE_NTWK_ADDR,
+  STATE_NTWK_ROLE,
+  STATE_COUNT,
+} state_field_t;
 
-ring_buffer_handle_t  gui_event_queue = {
-    .buffer   = &buffer,
-    .head     = 0,
-    .tail     = 0,
-    .size     = sizeof(gui_event_t),
-    .capacity = EVENT_QUEUE_BUFFER_SIZE,
+typedef struct {
+  ring_buffer_handle_t*     ring;       // NULL for the state lane
+  gui_event_queue_policy_t  policy;
+  gui_event_queue_stats_t   stats;
+} lane_state_t;
+
+RING_BUFFER_DEFINE(gui_input_events, gui_event_t, EVENT_QUEUE_INPUT_BUFFER_SIZE)
+RING_BUFFER_DEFINE(gui_log_events,   gui_event_t, EVENT_QUEUE_LOG_BUFFER_SIZE)
+
+static lane_state_t       lanes[GUI_EVENT_LANE_COUNT] = {
+    [GUI_EVENT_LANE_INPUT] = {
+        .ring   = &gui_input_events,
+        .policy = EVENT_QUEUE_INPUT_OVERFLOW_POLICY,
+    },
+    [GUI_EVENT_LANE_STATE] = {
+        .ring   = NULL,
+        .policy = GUI_EVENT_QUEUE_POLICY_REJECT,
+    },
+    [GUI_EVENT_LANE_LOG] = {
+        .ring   = &gui_log_events,
+        .policy = EVENT_QUEUE_LOG_OVERFLOW_POLICY,
+    },
 };
 
+static gui_event_t        state_events[STATE_COUNT];
+static uint32_t           state_pending;    // bit per state_field_t waiting to be rendered
+static gui_event_t        state_render;     // consumer copy of the state event being rendered
+
+static gui_event_lane_t gui_event_lane(uint32_t flag)
+{
+  if(flag & GUI_EVENT_FLAG_LOG)
+  {
+      return GUI_EVENT_LANE_LOG;
+  }
+
+  if(flag & GUI_EVENT_FLAGS_STATE)
+  {
+      return GUI_EVENT_LANE_STATE;
+  }
+
+  return GUI_EVENT_LANE_INPUT;
+}
+
+static state_field_t gui_event_state_field(uint32_t flag)
+{
+  switch(flag) {
+    case GUI_EVENT_FLAG_NTWK_NAME:
+      return STATE_NTWK_NAME;
+
+    case GUI_EVENT_FLAG_NTWK_CH:
+      return STATE_NTWK_CH;
+
+    case GUI_EVENT_FLAG_NTWK_ADDR:
+      return STATE_NTWK_ADDR;
+
+    case GUI_EVENT_FLAG_NTWK_ROLE:
+    default:
+      return STATE_NTWK_ROLE;
+  }
+}
+
+static uint32_t gui_event_state_depth(void)
+{
+  uint32_t depth = 0;
+
+  for(uint32_t pending = state_pending; pending; pending &= pending - 1)
+  {
+      depth++;
+  }
+
+  return depth;
+}
+
+// button an input event is for, -1 for the other lanes
+static int32_t gui_event_button(uint32_t flag)
+{
+  if(flag & (GUI_EVENT_FLAG_BTN0_PRESSED | GUI_EVENT_FLAG_BTN0_RELEASED))
+  {
+      return 0;
+  }
+
+  if(flag & (GUI_EVENT_FLAG_BTN1_PRESSED | GUI_EVENT_FLAG_BTN1_RELEASED))
+  {
+      return 1;
+  }
+
+  return -1;
+}
+
+// make room in a lane for an event with the given flag, called with interrupts
+// masked. the oldest event is never dropped since it may be getting rendered
+static sl_status_t gui_event_queue_make_room(lane_state_t* lane, uint32_t flag)
+{
+  gui_event_t* queued;
+  uint32_t     count;
+  uint32_t     victim   = 0;
+  int32_t      button;
+
+  switch(lane->policy) {
+    case GUI_EVENT_QUEUE_POLICY_OVERWRITE_OLDEST:
+      victim = 1;
+      break;
+
+    case GUI_EVENT_QUEUE_POLICY_COALESCE:
+      // only the latest state of a button has to reach the panel, an older
+      // event of the same button is superseded by the new one. the new event
+      // always goes in, a release is never lost to a full lane
+      count   = ring_buffer_count(lane->ring);
+      button  = gui_event_button(flag);
+      for(uint32_t offset = 1; (button >= 0) && (offset < count); offset++)
+      {
+          ring_buffer_entry(lane->ring, offset, (void **) &queued);
+
+          if(gui_event_button(queued->flag) == button)
+          {
+              victim = offset;
+              break;
+          }
+      }
+
+      if(victim != 0)
+      {
+          lane->stats.coalesced++;
+          return ring_buffer_remove(lane->ring, victim);
+      }
+
+      victim = 1;
+      break;
+
+    case GUI_EVENT_QUEUE_POLICY_REJECT:
+    default:
+      break;
+  }
+
+  lane->stats.dropped++;
+
+  // no victim, the new event is the one dropped
+  if(victim == 0)
+  {
+      return SL_STATUS_FULL;
+  }
+
+  return ring_buffer_remove(lane->ring, victim);
+}
+
+// account for a newly committed event, called with interrupts masked
+static void gui_event_queue_count_enqueued(lane_state_t* lane)
+{
+  uint32_t depth = (lane->ring != NULL) ? ring_buffer_count(lane->ring) : gui_event_state_depth();
+
+  lane->stats.enqueued++;
+
+  if(depth > lane->stats.high_watermark)
+  {
+      lane->stats.high_watermark = depth;
+  }
+}
+
 sl_status_t gui_event_queue_init(void)
 {
   sl_status_t error = SL_STATUS_OK;
+  REMOTE_PORT_DECLARE_CRITICAL;
+
+  REMOTE_PORT_ENTER_CRITICAL();
+  for(uint32_t i = 0; (i < GUI_EVENT_LANE_COUNT) && (error == SL_STATUS_OK); i++)
+  {
+      memset(&lanes[i].stats, 0, sizeof(lanes[i].stats));
+
+      if(lanes[i].ring != NULL)
+      {
+          error = ring_buffer_init(lanes[i].ring);
+      }
+  }
+  state_pending = 0;
+  REMOTE_PORT_EXIT_CRITICAL();
 
-  for(uint32_t i = 0; i < EVENT_QUEUE_BUFFER_SIZE; i++)
+  return error;
+}
+
+sl_status_t gui_event_queue_set_policy(gui_event_lane_t lane, gui_event_queue_policy_t policy)
+{
+  if((lane >= GUI_EVENT_LANE_COUNT) || (lanes[lane].ring == NULL) ||
+     (policy > GUI_EVENT_QUEUE_POLICY_COALESCE))
   {
-      buffer[i] = &gui_events[i];
+      return SL_STATUS_INVALID_PARAMETER;
   }
 
-  error = ring_buffer_init(&gui_event_queue);
+  lanes[lane].policy = policy;
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t gui_event_queue_get_stats(gui_event_lane_t lane, gui_event_queue_stats_t* stats)
+{
+  REMOTE_PORT_DECLARE_CRITICAL;
+
+  if(stats == NULL)
+  {
+      return SL_STATUS_NULL_POINTER;
+  }
+
+  if(lane >= GUI_EVENT_LANE_COUNT)
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  REMOTE_PORT_ENTER_CRITICAL();
+  *stats        = lanes[lane].stats;
+  stats->depth  = (lanes[lane].ring != NULL) ? ring_buffer_count(lanes[lane].ring) : gui_event_state_depth();
+  REMOTE_PORT_EXIT_CRITICAL();
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t gui_event_queue_add(const gui_event_t* event)
+{
+  sl_status_t   error = SL_STATUS_OK;
+  gui_event_t*  slot;
+  state_field_t field;
+  lane_state_t* lane;
+
+  REMOTE_PORT_DECLARE_CRITICAL;
+
+  if(event == NULL)
+  {
+      return SL_STATUS_NULL_POINTER;
+  }
+
+  lane = &lanes[gui_event_lane(event->flag)];
+
+  // the ring buffers allow a single producer, keep the button interrupt from
+  // preempting a main loop producer. the event is complete before the
+  // section starts so only the copy into the slot runs with interrupts masked
+  REMOTE_PORT_ENTER_CRITICAL();
+
+  if(lane->ring == NULL)
+  {
+      // state events are written over the field's slot, a pending older
+      // value is simply superseded
+      field = gui_event_state_field(event->flag);
+
+      if(state_pending & (1u << field))
+      {
+          lane->stats.coalesced++;
+      }
+
+      state_events[field]  = *event;
+      state_pending       |= (1u << field);
+  }
+  else
+  {
+      error = ring_buffer_reserve(lane->ring, (void **) &slot);
+
+      if(error == SL_STATUS_FULL)
+      {
+          error = gui_event_queue_make_room(lane, event->flag);
+          if(error == SL_STATUS_OK)
+          {
+              error = ring_buffer_reserve(lane->ring, (void **) &slot);
+          }
+      }
+
+      if(error == SL_STATUS_OK)
+      {
+          *slot = *event;
+          error = ring_buffer_commit(lane->ring);
+      }
+  }
+
+  if(error == SL_STATUS_OK)
+  {
+      gui_event_queue_count_enqueued(lane);
+  }
+
+  REMOTE_PORT_EXIT_CRITICAL();
 
   return error;
 }
+
+sl_status_t gui_event_queue_get(gui_event_lane_t lane, gui_event_t* event)
+{
+  sl_status_t  error;
+  gui_event_t* slot;
+
+  if(event == NULL)
+  {
+      return SL_STATUS_NULL_POINTER;
+  }
+
+  error = gui_event_queue_peek(lane, &slot);
+  if(error != SL_STATUS_OK)
+  {
+      return error;
+  }
+
+  *event = *slot;
+
+  return gui_event_queue_release(lane);
+}
+
+sl_status_t gui_event_queue_peek(gui_event_lane_t lane, gui_event_t** event)
+{
+  state_field_t field;
+  REMOTE_PORT_DECLARE_CRITICAL;
+
+  if(lane >= GUI_EVENT_LANE_COUNT)
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  if(lanes[lane].ring != NULL)
+  {
+      return ring_buffer_peek(lanes[lane].ring, (void **) event);
+  }
+
+  if(event == NULL)
+  {
+      return SL_STATUS_NULL_POINTER;
+  }
+
+  // take the latest value of the first pending field
+  REMOTE_PORT_ENTER_CRITICAL();
+  if(state_pending == 0)
+  {
+      REMOTE_PORT_EXIT_CRITICAL();
+      return SL_STATUS_EMPTY;
+  }
+
+  for(field = STATE_NTWK_NAME; !(state_pending & (1u << field)); field++);
+
+  state_render   = state_events[field];
+  state_pending &= ~(1u << field);
+  REMOTE_PORT_EXIT_CRITICAL();
+
+  *event = &state_render;
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t gui_event_queue_release(gui_event_lane_t lane)
+{
+  if(lane >= GUI_EVENT_LANE_COUNT)
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  // state events were copied out on peek
+  if(lanes[lane].ring == NULL)
+  {
+      return SL_STATUS_OK;
+  }
+
+  return ring_buffer_release(lanes[lane].ring);
+}
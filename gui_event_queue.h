@@ -38,8 +38,6 @@
 
 #include "ring_buffer.h"
 
-#define GUI_EVENT_MSG_SIZE              32u
-
 #define GUI_EVENT_FLAG_BTN0_PRESSED     (1 << 0)   // draw button right, true
 #define GUI_EVENT_FLAG_BTN0_RELEASED    (1 << 1)   // draw button right, false
 
@@ -53,13 +51,81 @@
 
 #define GUI_EVENT_FLAG_LOG              (1 << 8)
 
+// last value wins events, coalesced so each field is queued at most once
+#define GUI_EVENT_FLAGS_STATE           (GUI_EVENT_FLAG_NTWK_NAME | GUI_EVENT_FLAG_NTWK_CH | \
+                                         GUI_EVENT_FLAG_NTWK_ADDR | GUI_EVENT_FLAG_NTWK_ROLE)
+
+// fixed log messages, the text lives in gui.c and is only formatted when the
+// line is rendered
+typedef enum {
+  GUI_LOG_HELLO,              // no argument
+  GUI_LOG_READY_TO_JOIN,      // no argument
+  GUI_LOG_JOINER_SEARCHING,   // no argument
+  GUI_LOG_JOINER_JOINED,      // no argument
+  GUI_LOG_JOINER_ERROR,       // text: error string
+  GUI_LOG_COAP_TX,            // arg: answer character
+  GUI_LOG_COAP_LOST,          // arg: click seq
+  GUI_LOG_COUNT,
+} gui_log_id_t;
+
+// payload is picked by flag, values are raw and formatted at render time.
+// strings are resolved by the producer, the GUI knows nothing of OpenThread,
+// and must outlive the event (string literals or instance owned storage)
 typedef struct {
-  uint32_t  flag;
-  char      msg[GUI_EVENT_MSG_SIZE];
+  uint32_t            flag;
+  union {
+    uint8_t           channel;    // GUI_EVENT_FLAG_NTWK_CH
+    uint8_t           eui64[8];   // GUI_EVENT_FLAG_NTWK_ADDR
+    const char*       text;       // GUI_EVENT_FLAG_NTWK_NAME, GUI_EVENT_FLAG_NTWK_ROLE
+    struct {
+      uint16_t        id;         // gui_log_id_t
+      uint16_t        arg;
+      const char*     text;
+    } log;                        // GUI_EVENT_FLAG_LOG
+  };
 } gui_event_t;
 
-extern ring_buffer_handle_t gui_event_queue;
+// events are split in lanes by priority, gui_update drains the lanes in order
+// so button feedback never waits behind state updates or logs
+typedef enum {
+  GUI_EVENT_LANE_INPUT,       // button events
+  GUI_EVENT_LANE_STATE,       // GUI_EVENT_FLAGS_STATE events, latest value per field
+  GUI_EVENT_LANE_LOG,         // GUI_EVENT_FLAG_LOG events, in order
+  GUI_EVENT_LANE_COUNT,
+} gui_event_lane_t;
+
+// what to do with a new event when its lane is full, the state lane never is.
+// the event being rendered is never dropped
+typedef enum {
+  GUI_EVENT_QUEUE_POLICY_REJECT,                // drop the new event
+  GUI_EVENT_QUEUE_POLICY_OVERWRITE_OLDEST,      // drop the oldest queued event
+  GUI_EVENT_QUEUE_POLICY_COALESCE,              // drop the oldest queued event of the same
+                                                // button, the oldest queued one without
+} gui_event_queue_policy_t;
+
+typedef struct {
+  uint32_t  enqueued;         // events accepted since init
+  uint32_t  dropped;          // events lost to the overflow policy
+  uint32_t  coalesced;        // events superseded by a newer value before rendering
+  uint32_t  high_watermark;   // max number of queued events seen
+  uint32_t  depth;            // number of events currently queued
+} gui_event_queue_stats_t;
 
 sl_status_t gui_event_queue_init(void);
 
+sl_status_t gui_event_queue_set_policy(gui_event_lane_t lane, gui_event_queue_policy_t policy);
+sl_status_t gui_event_queue_get_stats(gui_event_lane_t lane, gui_event_queue_stats_t* stats);
+
+// events are produced from both the main loop and the button interrupt,
+// gui_event_queue_add serializes the producers so each lane stays SPSC.
+// producers build the whole event first, interrupts are only masked while
+// it is copied into its slot. the lane is picked from the event flag
+sl_status_t gui_event_queue_add(const gui_event_t* event);
+sl_status_t gui_event_queue_get(gui_event_lane_t lane, gui_event_t* event);
+
+// the GUI renders straight from the peeked slot then releases it. state
+// events are handed out as a copy so a newer value can land while rendering
+sl_status_t gui_event_queue_peek(gui_event_lane_t lane, gui_event_t** event);
+sl_status_t gui_event_queue_release(gui_event_lane_t lane);
+
 #endif /* GUI_EVENT_QUEUE_H_ */
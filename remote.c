@@ -38,21 +38,28 @@
 #include <openthread/dataset_ftd.h>
 #include <openthread/thread_ftd.h>
 #include <openthread/platform/misc.h>
+#include <openthread/random_noncrypto.h>
 
 #include <string.h>
 #include <stdlib.h>
 
 // Platform Drivers
+#include "em_core.h"
+#include "sl_sleeptimer.h"
 #include "sl_button.h"
 #include "sl_simple_button.h"
 #include "sl_simple_button_instances.h"
 
 // Utilities
 #include "printf.h"
+#include "remote_log.h"
 
 // Config
 #include "remote_config.h"
 #include "coap_client.h"
+#include "base_station_stub.h"
+#include "click_merge.h"
+#include "remote.h"
 
 #include "gui.h"
 #include "gui_event_queue.h"
@@ -62,13 +69,19 @@ void openthread_event_handler(otChangedFlags event, void *aContext);
 void joiner_callback(otError aError, void *aContext);
 
 static volatile uint8_t is_commissioned = false;
+static uint8_t          eui64[8];
 static char             mac_str[18];
 static otInstance*          sInstance = NULL;
+static uint16_t             click_seq;
+static uint16_t             boot_epoch;     // sent with click_seq, see remote.h
+
+// presses come from the button interrupt, the window ends in the sleeptimer
+// interrupt and the main loop takes the answers, all with interrupts masked
+static sl_sleeptimer_timer_handle_t click_timer;
+static click_merge_t        click_merge;
 
 static void device_set_mac_addr_str(char *str)
 {
-  uint8_t eui64[8];
-
   // get ieee eui
   otPlatRadioGetIeeeEui64(sInstance, (uint8_t *) &eui64);
 
@@ -76,43 +89,161 @@ static void device_set_mac_addr_str(char *str)
   str[17] = '\0';
 }
 
+#if COAP_CLIENT_NON_MODE && REMOTE_CLICK_PAYLOAD_ASCII
+#error "non-confirmable clicks need the sequence number of the binary payload"
+#endif
 
-void remote_init(otInstance *instance)
+// build the click payload for answer into payload, returns its length. nothing
+// is formatted here
+static uint16_t click_payload_build(char answer, uint8_t* payload)
+{
+  click_seq++;
+
+#if REMOTE_CLICK_PAYLOAD_ASCII
+  memcpy(payload, mac_str, 17);
+  payload[17] = ':';
+  payload[18] = ' ';
+  payload[19] = (uint8_t) answer;
+
+  return CLICK_PAYLOAD_ASCII_LEN;
+#else
+  uint32_t timestamp = sl_sleeptimer_tick_to_ms(sl_sleeptimer_get_tick_count());
+
+  payload[0]  = CLICK_PAYLOAD_VERSION;
+  memcpy(&payload[1], eui64, sizeof(eui64));
+  payload[9]  = (uint8_t) answer;
+  payload[10] = (uint8_t) (click_seq >> 8);
+  payload[11] = (uint8_t) click_seq;
+  payload[12] = (uint8_t) (timestamp >> 24);
+  payload[13] = (uint8_t) (timestamp >> 16);
+  payload[14] = (uint8_t) (timestamp >> 8);
+  payload[15] = (uint8_t) timestamp;
+  payload[16] = (uint8_t) (boot_epoch >> 8);
+  payload[17] = (uint8_t) boot_epoch;
+
+  return CLICK_PAYLOAD_LEN;
+#endif
+}
+
+static void click_timer_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+  bool restart;
+
+  (void) handle;
+  (void) data;
+
+  CORE_ATOMIC_SECTION(restart = click_merge_window_end(&click_merge);)
+
+  if(restart)
+  {
+      sl_sleeptimer_start_timer_ms(&click_timer, REMOTE_CLICK_WINDOW_MS, click_timer_callback, NULL, 0, 0);
+  }
+}
+
+// button interrupt, see click_merge.h
+static void click_press(char answer)
+{
+  bool start;
+
+  CORE_ATOMIC_SECTION(start = click_merge_press(&click_merge, answer);)
+
+  if(start)
+  {
+      sl_sleeptimer_start_timer_ms(&click_timer, REMOTE_CLICK_WINDOW_MS, click_timer_callback, NULL, 0, 0);
+  }
+}
+
+// text must outlive the event, see gui_event_t
+static void gui_log(gui_log_id_t id, uint16_t arg, const char* text)
 {
-  otError error;
   gui_event_t gui_event = {
-      .flag = 0,
-      .msg  = {0},
+      .flag     = GUI_EVENT_FLAG_LOG,
+      .log.id   = id,
+      .log.arg  = arg,
+      .log.text = text,
   };
 
+  gui_event_queue_add(&gui_event);
+}
+
+
+// the click never made it to the base station
+static void click_lost(void* context, uint16_t seq)
+{
+  (void) context;
+
+  gui_log(GUI_LOG_COAP_LOST, seq, NULL);
+}
+
+void remote_init(otInstance *instance)
+{
+  otError error;
+  gui_event_t gui_event = { .flag = GUI_EVENT_FLAG_NTWK_ADDR };
+
   // set openthread instance
   sInstance = instance;
 
   // get mac str
   device_set_mac_addr_str((char *) &mac_str);
 
+  click_merge_init(&click_merge, REMOTE_CLICK_WINDOW_MS);
+
+  // click_seq starts over with every boot, the epoch tells the runs apart
+  boot_epoch = otRandomNonCryptoGetUint16();
+
   // test logging output and application alive state
-  printf("Hello from the remote app_init\r\n");
+  REMOTE_LOG_INFO(REMOTE_LOG_HELLO);
 
-  gui_event.flag = GUI_EVENT_FLAG_LOG;
-  snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, "hello :)");
-  ring_buffer_add(&gui_event_queue, &gui_event);
+  gui_log(GUI_LOG_HELLO, 0, NULL);
 
-  gui_event.flag = GUI_EVENT_FLAG_NTWK_ADDR;
-  snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, (char *)&mac_str);
-  ring_buffer_add(&gui_event_queue, &gui_event);
+  memcpy(gui_event.eui64, eui64, sizeof(gui_event.eui64));
+  gui_event_queue_add(&gui_event);
 
   // delete previous network information
   error = otInstanceErasePersistentInfo(sInstance);
-  printf("erase persistent info: %s\r\n", otThreadErrorToString(error));
+  REMOTE_LOG_INFO(REMOTE_LOG_ERASE_PERSISTENT_INFO, error);
 
   // register callback for Thread Stack Events
   error = otSetStateChangedCallback(sInstance, openthread_event_handler, (void *)sInstance);
-  printf("set state changed callback: %s\r\n", otThreadErrorToString(error));
+  REMOTE_LOG_INFO(REMOTE_LOG_SET_STATE_CHANGED_CALLBACK, error);
 
   // start network interface
   error = otIp6SetEnabled(sInstance, true);
-  printf("enable interface: %s\r\n", otThreadErrorToString(error));
+  REMOTE_LOG_INFO(REMOTE_LOG_ENABLE_INTERFACE, error);
+}
+
+
+void remote_process(void)
+{
+#if REMOTE_CLICK_PAYLOAD_ASCII
+  uint8_t  payload[CLICK_PAYLOAD_ASCII_LEN];
+#else
+  uint8_t  payload[CLICK_PAYLOAD_LEN];
+#endif
+  uint16_t length;
+  char     answer;
+
+  if(!click_merge.due)
+  {
+      return;
+  }
+
+  CORE_ATOMIC_SECTION(answer = click_merge_take(&click_merge);)
+
+  if(answer == 0)
+  {
+      return;
+  }
+
+  gui_log(GUI_LOG_COAP_TX, (uint16_t) answer, NULL);
+
+  length = click_payload_build(answer, payload);
+
+  // send a message with some identifiable component
+  if(coap_client_send_message(sInstance, payload, length, click_seq) != OT_ERROR_NONE)
+  {
+      click_lost(NULL, click_seq);
+  }
 }
 
 
@@ -124,48 +255,54 @@ void remote_init(otInstance *instance)
  *****************************************************************************/
 void openthread_event_handler(otChangedFlags event, void *aContext)
 {
-  gui_event_t gui_event = {
-      .flag = 0,
-      .msg  = {0},
-  };
+  gui_event_t gui_event;
+
+  coap_client_state_changed(event);
 
   if(event & OT_CHANGED_THREAD_NETIF_STATE)
   {
       bool netif_state = otIp6IsEnabled(aContext);
-      printf("network if changed: %d\r\n", netif_state);
+      REMOTE_LOG_INFO(REMOTE_LOG_NETIF_CHANGED, netif_state);
       if(netif_state)
       {
-          printf("ready for join\r\n");
+          REMOTE_LOG_INFO(REMOTE_LOG_READY_TO_JOIN);
 
-          gui_event.flag = GUI_EVENT_FLAG_LOG;
-          snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, "press 'B' to join");
-          ring_buffer_add(&gui_event_queue, &gui_event);
+          gui_log(GUI_LOG_READY_TO_JOIN, 0, NULL);
       }
   }
 
   if(event & OT_CHANGED_THREAD_NETWORK_NAME)
   {
-      printf("network name changed: %s\r\n", otThreadGetNetworkName(aContext));
+      REMOTE_LOG_INFO_TEXT(REMOTE_LOG_NETWORK_NAME_CHANGED, otThreadGetNetworkName(aContext));
 
       gui_event.flag = GUI_EVENT_FLAG_NTWK_NAME;
-      snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, otThreadGetNetworkName(aContext));
-      ring_buffer_add(&gui_event_queue, &gui_event);
+      gui_event.text = otThreadGetNetworkName(aContext);
+      gui_event_queue_add(&gui_event);
   }
 
   if(event & OT_CHANGED_THREAD_ROLE)
   {
       otDeviceRole role = otThreadGetDeviceRole(aContext);
-      printf("Thread Device Role Changed: %s\r\n", otThreadDeviceRoleToString(role));
+      REMOTE_LOG_INFO(REMOTE_LOG_ROLE_CHANGED, role);
 
       gui_event.flag = GUI_EVENT_FLAG_NTWK_ROLE;
-      snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, otThreadDeviceRoleToString(role));
-      ring_buffer_add(&gui_event_queue, &gui_event);
+      gui_event.text = otThreadDeviceRoleToString(role);
+      gui_event_queue_add(&gui_event);
 
       if(role != OT_DEVICE_ROLE_DETACHED && role != OT_DEVICE_ROLE_DISABLED)
       {
           if(!is_commissioned)
           {
-              printf("coap client init: %s\r\n", otThreadErrorToString(coap_client_init(aContext)));
+              otError error = coap_client_init(aContext);
+              REMOTE_LOG_INFO(REMOTE_LOG_COAP_CLIENT_INIT, error);
+              coap_client_set_give_up_callback(click_lost, NULL);
+
+#if BASE_STATION_STUB_ENABLE
+              if(error == OT_ERROR_NONE)
+              {
+                  base_station_stub_init(aContext);
+              }
+#endif
               is_commissioned = true;
           }
       }
@@ -182,9 +319,9 @@ void openthread_event_handler(otChangedFlags event, void *aContext)
       {
 //          gui_print_network_channel(otDataset.mChannel);
 
-          gui_event.flag = GUI_EVENT_FLAG_NTWK_CH;
-          snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, "%d", otDataset.mChannel);
-          ring_buffer_add(&gui_event_queue, &gui_event);
+          gui_event.flag    = GUI_EVENT_FLAG_NTWK_CH;
+          gui_event.channel = (uint8_t) otDataset.mChannel;
+          gui_event_queue_add(&gui_event);
       }
 
   }
@@ -195,30 +332,21 @@ void openthread_event_handler(otChangedFlags event, void *aContext)
  *****************************************************************************/
 void joiner_callback(otError aError, void *aContext)
 {
-  gui_event_t gui_event = {
-      .flag = 0,
-      .msg  = {0},
-  };
-
-  printf("joiner_callback event: %s\r\n", otThreadErrorToString(aError));
+  REMOTE_LOG_INFO(REMOTE_LOG_JOINER_CALLBACK, aError);
 
   if(aError == OT_ERROR_NONE)
   {
       // successful join, start the thread
       // > thread start
       otError error = otThreadSetEnabled(aContext, true);
-      printf("thread start: %s\r\n", otThreadErrorToString(error));
+      REMOTE_LOG_INFO(REMOTE_LOG_THREAD_START, error);
 
-      gui_event.flag = GUI_EVENT_FLAG_LOG;
-      snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, "[joiner] joined :)");
-      ring_buffer_add(&gui_event_queue, &gui_event);
+      gui_log(GUI_LOG_JOINER_JOINED, 0, NULL);
 
   }
   else
   {
-      gui_event.flag = GUI_EVENT_FLAG_LOG;
-      snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, "[joiner] %s", otThreadErrorToString(aError));
-      ring_buffer_add(&gui_event_queue, &gui_event);
+      gui_log(GUI_LOG_JOINER_ERROR, 0, otThreadErrorToString(aError));
   }
 }
 
@@ -227,12 +355,6 @@ void joiner_callback(otError aError, void *aContext)
  *****************************************************************************/
 void sl_button_on_change(const sl_button_t *handle)
 {
-  char temp[21];
-  gui_event_t gui_event = {
-      .flag = 0,
-      .msg  = {0},
-  };
-
   if(sl_button_get_state(handle) == SL_SIMPLE_BUTTON_PRESSED)
   {
       if(!is_commissioned)
@@ -243,11 +365,9 @@ void sl_button_on_change(const sl_button_t *handle)
 
               // start joiner
               error = otJoinerStart(sInstance, JOINER_PSKD, NULL, NULL, NULL, NULL, NULL, joiner_callback, (void*)sInstance);
-              printf("start_joiner: %s\r\n", otThreadErrorToString(error));
+              REMOTE_LOG_INFO(REMOTE_LOG_JOINER_START, error);
 
-              gui_event.flag = GUI_EVENT_FLAG_LOG;
-              snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, "[joiner] searching...");
-              ring_buffer_add(&gui_event_queue, &gui_event);
+              gui_log(GUI_LOG_JOINER_SEARCHING, 0, NULL);
 
           }
       }
@@ -255,29 +375,22 @@ void sl_button_on_change(const sl_button_t *handle)
       {
           if(handle == &sl_button_btn0)
           {
-              gui_event.flag = GUI_EVENT_FLAG_LOG;
-              snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, "[coap] tx 'B'");
-              ring_buffer_add(&gui_event_queue, &gui_event);
-
-              snprintf((char *) &temp, 21, "%s: %c", mac_str, 'B');
-
-              // send a message with some identifiable component
-              coap_client_send_message(sInstance, temp);
+              click_press('B');
           }
 
           if(handle == &sl_button_btn1)
           {
-              gui_event.flag = GUI_EVENT_FLAG_LOG;
-              snprintf((char *)gui_event.msg, GUI_EVENT_MSG_SIZE, "[coap] tx 'A'");
-              ring_buffer_add(&gui_event_queue, &gui_event);
-
-              snprintf((char *) &temp, 21, "%s: %c", mac_str, 'A');
-
-              // send a message with some identifiable component
-              coap_client_send_message(sInstance, temp);
+              click_press('A');
           }
       }
   }
 
-  gui_button_handler(handle);
+  if(handle == &sl_button_btn0)
+  {
+      gui_button_handler(0, sl_button_get_state(handle) == SL_SIMPLE_BUTTON_PRESSED);
+  }
+  else if(handle == &sl_button_btn1)
+  {
+      gui_button_handler(1, sl_button_get_state(handle) == SL_SIMPLE_BUTTON_PRESSED);
+  }
 }
@@ -37,6 +37,32 @@
 #ifndef REMOTE_H_
 #define REMOTE_H_
 
+// binary click payload, multi-byte fields are big endian
+//   [0]      version
+//   [1..8]   EUI-64
+//   [9]      answer, 'A' or 'B'
+//   [10..11] sequence number, incremented per click, 1 is the first of a boot
+//   [12..15] local timestamp in ms
+//   [16..17] boot epoch, random per boot. (EUI-64, epoch) names one run of
+//            the sequence numbers so a receiver tells a reboot from a late copy
+//
+// on air a click is one unfragmented 802.15.4 frame either way. besides the
+// payload it carries 6 bytes of PHY header, 9 of MAC header, 6 of auxiliary
+// security header, 4 of MIC, 2 of FCS, 3 of IPHC, 7 of compressed UDP and 23
+// of CoAP (header, 2 byte token, "question/answer" and the payload marker),
+// 60 bytes in all. a binary click is 60 + 18 = 78 bytes or 2496 us at
+// 250 kbps, an ASCII click 60 + 20 = 80 bytes or 2560 us. the binary payload
+// carries seq, timestamp and epoch in 2 bytes less, a 16-bit epoch means one
+// reboot in 65536 reuses the epoch of the run before it
+#define CLICK_PAYLOAD_VERSION     1
+#define CLICK_PAYLOAD_LEN         18
+
+// "XX:XX:XX:XX:XX:XX: A"
+#define CLICK_PAYLOAD_ASCII_LEN   20
+
 void remote_init(otInstance *instance);
 
+// sends the click of a closed aggregation window, call from the main loop
+void remote_process(void);
+
 #endif /* REMOTE_H_ */
@@ -39,4 +39,24 @@
 
 #define JOINER_PSKD      "J01NME"
 
+// 1 sends the original "XX:XX:XX:XX:XX:XX: A" text payload for base
+// stations that don't understand the binary click payload
+#ifndef REMOTE_CLICK_PAYLOAD_ASCII
+#define REMOTE_CLICK_PAYLOAD_ASCII        0
+#endif
+
+// the first press goes out right away, later presses within this window
+// collapse into one click carrying the last answer, sent when the window
+// ends unless it is the answer already sent. 0 opens no window, only presses
+// closer together than one pass of the main loop still collapse
+#ifndef REMOTE_CLICK_WINDOW_MS
+#define REMOTE_CLICK_WINDOW_MS            200
+#endif
+
+// the base station registers a Thread Network Data service with this
+// enterprise number and service data, the closest server is used as the CoAP
+// destination. without one the leader is assumed to be the base station
+#define BASE_STATION_ENTERPRISE_NUMBER    44970
+#define BASE_STATION_SERVICE_DATA         "openclicker"
+
 #endif /* REMOTE_CONFIG_H_ */
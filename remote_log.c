@@ -0,0 +1,188 @@
+/***************************************************************************//**
+ * @file
+ * @brief Deferred Binary Logging
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <string.h>
+
+#include "remote_port.h"
+#include "printf.h"
+
+#include "ring_buffer.h"
+#include "remote_log.h"
+
+RING_BUFFER_DEFINE(log_ring, remote_log_record_t, REMOTE_LOG_RING_LEN)
+
+static  uint32_t            dropped;
+static  uint32_t            dropped_reported;
+
+void remote_log_write(uint8_t level, remote_log_id_t id, const char* text, uint32_t a0, uint32_t a1, uint32_t a2)
+{
+  remote_log_record_t record = {
+      .id       = (uint16_t) id,
+      .level    = level,
+      .text_len = 0,
+      .args     = { a0, a1, a2 },
+  };
+
+  // the text is copied now, the caller's buffer may be gone when it is sent
+  while((text != NULL) && (record.text_len < REMOTE_LOG_TEXT_LEN) && (text[record.text_len] != '\0'))
+  {
+      record.text[record.text_len] = text[record.text_len];
+      record.text_len++;
+  }
+
+  REMOTE_PORT_DECLARE_CRITICAL;
+
+  // interrupt handlers log too, one producer at a time
+  REMOTE_PORT_ENTER_CRITICAL();
+
+  if(log_ring_add(&record) != SL_STATUS_OK)
+  {
+      dropped++;
+  }
+
+  REMOTE_PORT_EXIT_CRITICAL();
+}
+
+// COBS, replaces every zero so 0x00 only ever marks the frame ends. the
+// payload is shorter than 254 bytes, a single block
+static uint32_t cobs_encode(const uint8_t* in, uint32_t length, uint8_t* out)
+{
+  uint32_t  code_index  = 0;
+  uint32_t  out_length  = 1;
+  uint8_t   code        = 1;
+
+  for(uint32_t i = 0; i < length; i++)
+  {
+      if(in[i] == 0)
+      {
+          out[code_index] = code;
+          code_index      = out_length++;
+          code            = 1;
+      }
+      else
+      {
+          out[out_length++] = in[i];
+          code++;
+      }
+  }
+
+  out[code_index] = code;
+
+  return out_length;
+}
+
+uint32_t remote_log_encode(const remote_log_record_t* record, uint8_t* frame)
+{
+  uint8_t   payload[REMOTE_LOG_PAYLOAD_MAX];
+  uint32_t  length  = 0;
+  uint32_t  argc    = REMOTE_LOG_ARGS;
+  uint32_t  text_len;
+
+  // zero arguments at the end are implied
+  while((argc > 0) && (record->args[argc - 1] == 0))
+  {
+      argc--;
+  }
+
+  payload[length++] = record->level;
+  payload[length++] = (uint8_t) record->id;
+  payload[length++] = (uint8_t) (record->id >> 8);
+  payload[length++] = (uint8_t) argc;
+
+  for(uint32_t i = 0; i < argc; i++)
+  {
+      payload[length++] = (uint8_t) record->args[i];
+      payload[length++] = (uint8_t) (record->args[i] >> 8);
+      payload[length++] = (uint8_t) (record->args[i] >> 16);
+      payload[length++] = (uint8_t) (record->args[i] >> 24);
+  }
+
+  text_len = (record->text_len > REMOTE_LOG_TEXT_LEN) ? REMOTE_LOG_TEXT_LEN : record->text_len;
+  memcpy(&payload[length], record->text, text_len);
+  length += text_len;
+
+  frame[0] = 0;
+  length   = 1 + cobs_encode(payload, length, &frame[1]);
+  frame[length++] = 0;
+
+  return length;
+}
+
+static void remote_log_send(const remote_log_record_t* record)
+{
+  uint8_t   frame[REMOTE_LOG_FRAME_MAX];
+  uint32_t  length = remote_log_encode(record, frame);
+
+  for(uint32_t i = 0; i < length; i++)
+  {
+      _putchar((char) frame[i]);
+  }
+}
+
+void remote_log_process(void)
+{
+  remote_log_record_t records[REMOTE_LOG_RECORDS_PER_PROCESS];
+  uint32_t            count;
+  uint32_t            lost = dropped;
+
+  if(lost != dropped_reported)
+  {
+      remote_log_record_t report = {
+          .id     = REMOTE_LOG_DROPPED,
+          .level  = REMOTE_LOG_LEVEL_ERROR,
+          .args   = { lost - dropped_reported },
+      };
+
+      remote_log_send(&report);
+      dropped_reported = lost;
+  }
+
+  count = ring_buffer_get_n(&log_ring, records, REMOTE_LOG_RECORDS_PER_PROCESS);
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+      remote_log_send(&records[i]);
+  }
+}
+
+bool remote_log_is_pending(void)
+{
+  return (dropped != dropped_reported) || (ring_buffer_count(&log_ring) > 0);
+}
+
+uint32_t remote_log_get_dropped(void)
+{
+  return dropped;
+}
@@ -0,0 +1,173 @@
+/***************************************************************************//**
+ * @file
+ * @brief Deferred Binary Logging Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef REMOTE_LOG_H_
+#define REMOTE_LOG_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sl_status.h"
+#include "remote_log_messages.h"
+
+// Log sites store a record of a message id plus up to three raw arguments in
+// a ring, remote_log_process sends them from the main loop as binary frames
+// and tools/remote_log_decode.py formats them on the host. Levels above
+// REMOTE_LOG_LEVEL compile out completely.
+//
+// Arguments are stored as uint32_t. Strings can't be sent as pointers, ids
+// like otError and otDeviceRole go out as numbers and are named by the
+// decoder, the one string a record can carry is copied into it by the _TEXT
+// variants.
+//
+// Frame on the wire: 0x00, then COBS encoded
+//   level (1), id (2, little endian), argc (1), argc args (4 each, little
+//   endian), text (rest of the frame)
+// then 0x00. Trailing zero arguments are not sent. The zero bytes keep the
+// frames apart from any plain printf output on the same port.
+#define REMOTE_LOG_LEVEL_NONE     0
+#define REMOTE_LOG_LEVEL_ERROR    1
+#define REMOTE_LOG_LEVEL_INFO     2
+#define REMOTE_LOG_LEVEL_DEBUG    3
+
+#ifndef REMOTE_LOG_LEVEL
+#define REMOTE_LOG_LEVEL          REMOTE_LOG_LEVEL_INFO
+#endif
+
+// records buffered between two remote_log_process calls, power of two
+#ifndef REMOTE_LOG_RING_LEN
+#define REMOTE_LOG_RING_LEN       32
+#endif
+
+// records sent per remote_log_process call
+#ifndef REMOTE_LOG_RECORDS_PER_PROCESS
+#define REMOTE_LOG_RECORDS_PER_PROCESS  4
+#endif
+
+// bytes of text a record carries, a Thread network name fits
+#ifndef REMOTE_LOG_TEXT_LEN
+#define REMOTE_LOG_TEXT_LEN       16
+#endif
+
+#define REMOTE_LOG_ARGS           3
+
+// payload without the COBS overhead
+#define REMOTE_LOG_PAYLOAD_MAX    (4 + (4 * REMOTE_LOG_ARGS) + REMOTE_LOG_TEXT_LEN)
+
+// leading zero, one COBS code byte per 254 payload bytes, trailing zero
+#define REMOTE_LOG_FRAME_MAX      (REMOTE_LOG_PAYLOAD_MAX + 3)
+
+_Static_assert(REMOTE_LOG_PAYLOAD_MAX < 254, "a frame is a single COBS block");
+
+// log messages, the formats live in remote_log_messages.h
+#define REMOTE_LOG_ID(id, format)   id,
+typedef enum {
+  REMOTE_LOG_MESSAGES(REMOTE_LOG_ID)
+  REMOTE_LOG_COUNT,
+} remote_log_id_t;
+#undef REMOTE_LOG_ID
+
+typedef struct {
+  uint16_t  id;
+  uint8_t   level;
+  uint8_t   text_len;
+  uint32_t  args[REMOTE_LOG_ARGS];
+  char      text[REMOTE_LOG_TEXT_LEN];
+} remote_log_record_t;
+
+// pads the argument list to three so every site calls remote_log_write
+#define REMOTE_LOG_WRITE(level, ...)  REMOTE_LOG_WRITE_(level, __VA_ARGS__, 0, 0, 0, 0)
+#define REMOTE_LOG_WRITE_(level, id, a0, a1, a2, ...) \
+  remote_log_write((level), (id), NULL, (uint32_t) (a0), (uint32_t) (a1), (uint32_t) (a2))
+
+// same with the text the format prints for %s, copied into the record
+#define REMOTE_LOG_WRITE_TEXT(level, ...)  REMOTE_LOG_WRITE_TEXT_(level, __VA_ARGS__, 0, 0, 0)
+#define REMOTE_LOG_WRITE_TEXT_(level, id, text, a0, a1, a2, ...) \
+  remote_log_write((level), (id), (text), (uint32_t) (a0), (uint32_t) (a1), (uint32_t) (a2))
+
+// disabled sites still reference their arguments so nothing turns unused,
+// the dead branch is dropped by the compiler
+#define REMOTE_LOG_DISABLED(...) \
+  do { if(0) { REMOTE_LOG_WRITE(REMOTE_LOG_LEVEL_NONE, __VA_ARGS__); } } while(0)
+#define REMOTE_LOG_DISABLED_TEXT(...) \
+  do { if(0) { REMOTE_LOG_WRITE_TEXT(REMOTE_LOG_LEVEL_NONE, __VA_ARGS__); } } while(0)
+
+#if REMOTE_LOG_LEVEL >= REMOTE_LOG_LEVEL_ERROR
+#define REMOTE_LOG_ERROR(...)       REMOTE_LOG_WRITE(REMOTE_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define REMOTE_LOG_ERROR_TEXT(...)  REMOTE_LOG_WRITE_TEXT(REMOTE_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define REMOTE_LOG_ERROR(...)       REMOTE_LOG_DISABLED(__VA_ARGS__)
+#define REMOTE_LOG_ERROR_TEXT(...)  REMOTE_LOG_DISABLED_TEXT(__VA_ARGS__)
+#endif
+
+#if REMOTE_LOG_LEVEL >= REMOTE_LOG_LEVEL_INFO
+#define REMOTE_LOG_INFO(...)        REMOTE_LOG_WRITE(REMOTE_LOG_LEVEL_INFO, __VA_ARGS__)
+#define REMOTE_LOG_INFO_TEXT(...)   REMOTE_LOG_WRITE_TEXT(REMOTE_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define REMOTE_LOG_INFO(...)        REMOTE_LOG_DISABLED(__VA_ARGS__)
+#define REMOTE_LOG_INFO_TEXT(...)   REMOTE_LOG_DISABLED_TEXT(__VA_ARGS__)
+#endif
+
+#if REMOTE_LOG_LEVEL >= REMOTE_LOG_LEVEL_DEBUG
+#define REMOTE_LOG_DEBUG(...)       REMOTE_LOG_WRITE(REMOTE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define REMOTE_LOG_DEBUG_TEXT(...)  REMOTE_LOG_WRITE_TEXT(REMOTE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define REMOTE_LOG_DEBUG(...)       REMOTE_LOG_DISABLED(__VA_ARGS__)
+#define REMOTE_LOG_DEBUG_TEXT(...)  REMOTE_LOG_DISABLED_TEXT(__VA_ARGS__)
+#endif
+
+// store a record, safe from interrupt context. text may be NULL, it is cut
+// to REMOTE_LOG_TEXT_LEN. the record is dropped and counted when the ring is
+// full
+void        remote_log_write(uint8_t level, remote_log_id_t id, const char* text, uint32_t a0, uint32_t a1, uint32_t a2);
+
+// send up to REMOTE_LOG_RECORDS_PER_PROCESS records through _putchar, main
+// loop only. records lost since the last call are reported first as a
+// REMOTE_LOG_DROPPED record
+void        remote_log_process(void);
+
+// records or a drop report are left for remote_log_process, the main loop
+// doesn't sleep then
+bool        remote_log_is_pending(void);
+
+// frame a record for the wire, returns the number of bytes written to frame
+// which must hold REMOTE_LOG_FRAME_MAX
+uint32_t    remote_log_encode(const remote_log_record_t* record, uint8_t* frame);
+
+// records lost to a full ring since boot
+uint32_t    remote_log_get_dropped(void);
+
+#endif /* REMOTE_LOG_H_ */
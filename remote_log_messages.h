@@ -0,0 +1,82 @@
+/***************************************************************************//**
+ * @file
+ * @brief Remote Log Message Table
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef REMOTE_LOG_MESSAGES_H_
+#define REMOTE_LOG_MESSAGES_H_
+
+// id and format of every log message. the target only sends the id and the
+// raw arguments, tools/remote_log_decode.py reads this table to turn records
+// back into text, so keep one X(id, "format") per line. new ids go at the end
+// to keep old captures decodable.
+//
+// numeric arguments are 32-bit and take %u, %d, %x and %c with printf flags
+// and width, %E prints an otError and %R an otDeviceRole by name. %s is the
+// text of the record, see REMOTE_LOG_INFO_TEXT
+#define REMOTE_LOG_MESSAGES(X)                                                          \
+  X(REMOTE_LOG_HELLO,                       "Hello from the remote app_init")           \
+  X(REMOTE_LOG_ERASE_PERSISTENT_INFO,       "erase persistent info: %E")                \
+  X(REMOTE_LOG_SET_STATE_CHANGED_CALLBACK,  "set state changed callback: %E")           \
+  X(REMOTE_LOG_ENABLE_INTERFACE,            "enable interface: %E")                     \
+  X(REMOTE_LOG_NETIF_CHANGED,               "network if changed: %d")                   \
+  X(REMOTE_LOG_READY_TO_JOIN,               "ready for join")                           \
+  X(REMOTE_LOG_NETWORK_NAME_CHANGED,        "network name changed: %s")                 \
+  X(REMOTE_LOG_ROLE_CHANGED,                "Thread Device Role Changed: %R")           \
+  X(REMOTE_LOG_COAP_CLIENT_INIT,            "coap client init: %E")                     \
+  X(REMOTE_LOG_JOINER_CALLBACK,             "joiner_callback event: %E")                \
+  X(REMOTE_LOG_THREAD_START,                "thread start: %E")                         \
+  X(REMOTE_LOG_JOINER_START,                "start_joiner: %E")                         \
+  X(REMOTE_LOG_COAP_START,                  "coap client start: %E")                    \
+  X(REMOTE_LOG_COAP_NOT_ENABLED,            "coap not enabled")                         \
+  X(REMOTE_LOG_COAP_LEADER_RLOC,            "get leader rloc: %E")                      \
+  X(REMOTE_LOG_COAP_BASE_STATION,           "base station service at rloc16 0x%04x")    \
+  X(REMOTE_LOG_COAP_NEW_MESSAGE,            "coap request init message: %E")            \
+  X(REMOTE_LOG_COAP_URI_PATH,               "coap request append uri-path: %E")         \
+  X(REMOTE_LOG_COAP_PAYLOAD_MARKER,         "set payload marker: %E")                   \
+  X(REMOTE_LOG_COAP_APPEND_PAYLOAD,         "append payload to message: %E")            \
+  X(REMOTE_LOG_COAP_TX,                     "sending %u bytes to rloc16 0x%04x")        \
+  X(REMOTE_LOG_COAP_SEND,                   "send coap request: %E")                    \
+  X(REMOTE_LOG_COAP_RESPONSE,               "coap client handler: %E")                  \
+  X(REMOTE_LOG_COAP_NON_ACK,                "coap ack: %u, 0x%08x")                     \
+  X(REMOTE_LOG_COAP_NON_GIVE_UP,            "coap click %u not acked, dropped")         \
+  X(REMOTE_LOG_STUB_CLICK,                  "[stub] click %u '%c'")                     \
+  X(REMOTE_LOG_STUB_DUPLICATE,              "[stub] duplicate click %u")                \
+  X(REMOTE_LOG_GUI_EVENT,                   "\tflag: %u")                               \
+  X(REMOTE_LOG_GUI_INIT,                    "[gui] init failed: 0x%04x")                \
+  X(REMOTE_LOG_DROPPED,                     "log: %u records dropped")                  \
+  X(REMOTE_LOG_COAP_BASE_STATION_FAILED,    "base station at rloc16 0x%04x timed out")  \
+  X(REMOTE_LOG_STUB_REFUSED,                "[stub] click %u refused, device table full") \
+  X(REMOTE_LOG_COAP_NON_ACK_IGNORED,        "coap ack from rloc16 0x%04x ignored")
+
+#endif /* REMOTE_LOG_MESSAGES_H_ */
@@ -0,0 +1,84 @@
+/***************************************************************************//**
+ * @file
+ * @brief Platform Port Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef REMOTE_PORT_H_
+#define REMOTE_PORT_H_
+
+#include <stdint.h>
+
+// Platform services of the modules that also build on the host (GUI, event
+// queue, log). On the target a critical section masks interrupts, the host
+// tests define REMOTE_PORT_HOST and drive those modules from a single thread
+// so the section only has to be counted.
+#if defined(REMOTE_PORT_HOST)
+
+typedef uint32_t remote_port_irq_state_t;
+
+// nesting depth, lets the host tests check every section is closed
+extern uint32_t remote_port_critical_depth;
+
+static inline remote_port_irq_state_t remote_port_enter_critical(void)
+{
+  return remote_port_critical_depth++;
+}
+
+static inline void remote_port_exit_critical(remote_port_irq_state_t state)
+{
+  remote_port_critical_depth = state;
+}
+
+#else
+
+#include "em_core.h"
+
+typedef CORE_irqState_t remote_port_irq_state_t;
+
+static inline remote_port_irq_state_t remote_port_enter_critical(void)
+{
+  return CORE_EnterAtomic();
+}
+
+static inline void remote_port_exit_critical(remote_port_irq_state_t state)
+{
+  CORE_ExitAtomic(state);
+}
+
+#endif
+
+#define REMOTE_PORT_DECLARE_CRITICAL  remote_port_irq_state_t remote_port_irq_state
+#define REMOTE_PORT_ENTER_CRITICAL()  (remote_port_irq_state = remote_port_enter_critical())
+#define REMOTE_PORT_EXIT_CRITICAL()   remote_port_exit_critical(remote_port_irq_state)
+
+#endif /* REMOTE_PORT_H_ */
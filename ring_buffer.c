@@ -35,16 +35,15 @@
  ******************************************************************************/
 #include <string.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "sl_status.h"
 #include "ring_buffer.h"
 
-#define BUFFER_SIZE 10
-
 #define CHECK_NULL(p)   {if(p == 0) return SL_STATUS_NULL_POINTER;}
 
-static inline uint32_t  _ring_buffer_count( ring_buffer_handle_t* handle )
+static inline uint32_t  _ring_buffer_count( uint32_t head, uint32_t tail )
 {
-  return (handle->head - handle->tail);
+  return (head - tail);
 }
 
 static inline uint32_t  _ring_buffer_capacity( ring_buffer_handle_t* handle )
@@ -52,14 +51,14 @@ static inline uint32_t  _ring_buffer_capacity( ring_buffer_handle_t* handle )
   return handle->capacity;
 }
 
-static inline bool      _ring_buffer_full( ring_buffer_handle_t* handle )
+static inline bool      _ring_buffer_full( ring_buffer_handle_t* handle, uint32_t head, uint32_t tail )
 {
-  return (_ring_buffer_count(handle) == _ring_buffer_capacity(handle));
+  return (_ring_buffer_count(head, tail) == _ring_buffer_capacity(handle));
 }
 
-static inline bool      _ring_buffer_empty( ring_buffer_handle_t* handle )
+static inline bool      _ring_buffer_empty( uint32_t head, uint32_t tail )
 {
-  return (handle->tail == handle->head);
+  return (tail == head);
 }
 
 static inline uint32_t _ring_buffer_mask( ring_buffer_handle_t* handle, uint32_t value)
@@ -67,6 +66,16 @@ static inline uint32_t _ring_buffer_mask( ring_buffer_handle_t* handle, uint32_t
   return value & (handle->capacity - 1);
 }
 
+static inline uint32_t _ring_buffer_min( uint32_t a, uint32_t b)
+{
+  return (a < b) ? a : b;
+}
+
+static inline void*    _ring_buffer_slot( ring_buffer_handle_t* handle, uint32_t index)
+{
+  return (uint8_t *) handle->buffer + (_ring_buffer_mask(handle, index) * handle->size);
+}
+
 
 // initialization
 sl_status_t ring_buffer_init( ring_buffer_handle_t* handle )
@@ -75,9 +84,15 @@ sl_status_t ring_buffer_init( ring_buffer_handle_t* handle )
 
   CHECK_NULL(handle->buffer);
 
+  // indices are wrapped with a mask
+  if( (handle->capacity == 0) || (handle->capacity & (handle->capacity - 1)) )
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
   // reset head and tail
-  handle->head = 0;
-  handle->tail = 0;
+  atomic_store_explicit(&handle->head, 0, memory_order_relaxed);
+  atomic_store_explicit(&handle->tail, 0, memory_order_relaxed);
 
   return SL_STATUS_OK;
 }
@@ -88,8 +103,8 @@ sl_status_t ring_buffer_reset( ring_buffer_handle_t* handle )
   CHECK_NULL(handle);
 
   // this might be redundant, could just call init
-  handle->head = 0;
-  handle->tail = 0;
+  atomic_store_explicit(&handle->head, 0, memory_order_relaxed);
+  atomic_store_explicit(&handle->tail, 0, memory_order_relaxed);
 
   return SL_STATUS_OK;
 }
@@ -97,43 +112,255 @@ sl_status_t ring_buffer_reset( ring_buffer_handle_t* handle )
 // add
 sl_status_t ring_buffer_add( ring_buffer_handle_t* handle, void* data)
 {
-  uint32_t* src, dst;
+  sl_status_t error;
+  void*       dst;
 
-  CHECK_NULL(handle);
   CHECK_NULL(data);
 
-  if( _ring_buffer_full(handle) )
+  error = ring_buffer_reserve(handle, &dst);
+  if( error != SL_STATUS_OK )
   {
-      return SL_STATUS_FULL;
+      return error;
   }
 
-  src = data;
-  dst = handle->buffer[ _ring_buffer_mask(handle, handle->head++) ];
-
   // copy data to buffer @ head
-  memcpy(dst, src, handle->size);
+  memcpy(dst, data, handle->size);
 
-  return SL_STATUS_OK;
+  return ring_buffer_commit(handle);
 }
 
 // get
 sl_status_t ring_buffer_get( ring_buffer_handle_t* handle, void* data)
 {
-  uint32_t* src, dst;
+  sl_status_t error;
+  void*       src;
 
-  CHECK_NULL(handle);
   CHECK_NULL(data);
 
-  if( _ring_buffer_empty(handle) )
+  error = ring_buffer_peek(handle, &src);
+  if( error != SL_STATUS_OK )
+  {
+      return error;
+  }
+
+  // copy buffer to data
+  memcpy(data, src, handle->size);
+
+  return ring_buffer_release(handle);
+}
+
+// add n
+uint32_t ring_buffer_add_n( ring_buffer_handle_t* handle, const void* data, uint32_t count)
+{
+  uint32_t head, tail, first, index;
+
+  if( (handle == NULL) || (data == NULL) )
+  {
+      return 0;
+  }
+
+  head = atomic_load_explicit(&handle->head, memory_order_relaxed);
+  tail = atomic_load_explicit(&handle->tail, memory_order_acquire);
+
+  // clamp to free space
+  count = _ring_buffer_min(count, _ring_buffer_capacity(handle) - _ring_buffer_count(head, tail));
+  if( count == 0 )
+  {
+      return 0;
+  }
+
+  // copy in at most two spans, up to the end of the buffer then from the start
+  index = _ring_buffer_mask(handle, head);
+  first = _ring_buffer_min(count, _ring_buffer_capacity(handle) - index);
+
+  memcpy(_ring_buffer_slot(handle, head), data, first * handle->size);
+  memcpy(handle->buffer, (const uint8_t *) data + (first * handle->size), (count - first) * handle->size);
+
+  // publish all entries at once
+  atomic_store_explicit(&handle->head, head + count, memory_order_release);
+
+  return count;
+}
+
+// get n
+uint32_t ring_buffer_get_n( ring_buffer_handle_t* handle, void* data, uint32_t count)
+{
+  uint32_t head, tail, first, index;
+
+  if( (handle == NULL) || (data == NULL) )
+  {
+      return 0;
+  }
+
+  tail = atomic_load_explicit(&handle->tail, memory_order_relaxed);
+  head = atomic_load_explicit(&handle->head, memory_order_acquire);
+
+  // clamp to available entries
+  count = _ring_buffer_min(count, _ring_buffer_count(head, tail));
+  if( count == 0 )
+  {
+      return 0;
+  }
+
+  // copy out in at most two spans, up to the end of the buffer then from the start
+  index = _ring_buffer_mask(handle, tail);
+  first = _ring_buffer_min(count, _ring_buffer_capacity(handle) - index);
+
+  memcpy(data, _ring_buffer_slot(handle, tail), first * handle->size);
+  memcpy((uint8_t *) data + (first * handle->size), handle->buffer, (count - first) * handle->size);
+
+  // hand all slots back at once
+  atomic_store_explicit(&handle->tail, tail + count, memory_order_release);
+
+  return count;
+}
+
+// reserve
+sl_status_t ring_buffer_reserve( ring_buffer_handle_t* handle, void** slot)
+{
+  uint32_t head, tail;
+
+  CHECK_NULL(handle);
+  CHECK_NULL(slot);
+
+  // head is only written by the producer, tail is published by the consumer
+  head = atomic_load_explicit(&handle->head, memory_order_relaxed);
+  tail = atomic_load_explicit(&handle->tail, memory_order_acquire);
+
+  if( _ring_buffer_full(handle, head, tail) )
+  {
+      return SL_STATUS_FULL;
+  }
+
+  *slot = _ring_buffer_slot(handle, head);
+
+  return SL_STATUS_OK;
+}
+
+// commit
+sl_status_t ring_buffer_commit( ring_buffer_handle_t* handle)
+{
+  uint32_t head, tail;
+
+  CHECK_NULL(handle);
+
+  head = atomic_load_explicit(&handle->head, memory_order_relaxed);
+  tail = atomic_load_explicit(&handle->tail, memory_order_acquire);
+
+  if( _ring_buffer_full(handle, head, tail) )
+  {
+      return SL_STATUS_FULL;
+  }
+
+  // publish the slot to the consumer
+  atomic_store_explicit(&handle->head, head + 1, memory_order_release);
+
+  return SL_STATUS_OK;
+}
+
+// peek
+sl_status_t ring_buffer_peek( ring_buffer_handle_t* handle, void** slot)
+{
+  uint32_t head, tail;
+
+  CHECK_NULL(handle);
+  CHECK_NULL(slot);
+
+  // tail is only written by the consumer, head is published by the producer
+  tail = atomic_load_explicit(&handle->tail, memory_order_relaxed);
+  head = atomic_load_explicit(&handle->head, memory_order_acquire);
+
+  if( _ring_buffer_empty(head, tail) )
   {
       return SL_STATUS_EMPTY;
   }
 
-  src = handle->buffer[ _ring_buffer_mask(handle, handle->tail++) ];
-  dst = data;
+  *slot = _ring_buffer_slot(handle, tail);
 
-  // copy buffer to data
-  memcpy(dst, src, handle->size);
+  return SL_STATUS_OK;
+}
+
+// release
+sl_status_t ring_buffer_release( ring_buffer_handle_t* handle)
+{
+  uint32_t head, tail;
+
+  CHECK_NULL(handle);
+
+  tail = atomic_load_explicit(&handle->tail, memory_order_relaxed);
+  head = atomic_load_explicit(&handle->head, memory_order_acquire);
+
+  if( _ring_buffer_empty(head, tail) )
+  {
+      return SL_STATUS_EMPTY;
+  }
+
+  // hand the slot back to the producer
+  atomic_store_explicit(&handle->tail, tail + 1, memory_order_release);
+
+  return SL_STATUS_OK;
+}
+
+// count
+uint32_t ring_buffer_count( ring_buffer_handle_t* handle)
+{
+  uint32_t head, tail;
+
+  if( handle == NULL )
+  {
+      return 0;
+  }
+
+  tail = atomic_load_explicit(&handle->tail, memory_order_acquire);
+  head = atomic_load_explicit(&handle->head, memory_order_acquire);
+
+  return _ring_buffer_count(head, tail);
+}
+
+// entry
+sl_status_t ring_buffer_entry( ring_buffer_handle_t* handle, uint32_t offset, void** slot)
+{
+  uint32_t head, tail;
+
+  CHECK_NULL(handle);
+  CHECK_NULL(slot);
+
+  head = atomic_load_explicit(&handle->head, memory_order_relaxed);
+  tail = atomic_load_explicit(&handle->tail, memory_order_acquire);
+
+  if( offset >= _ring_buffer_count(head, tail) )
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  *slot = _ring_buffer_slot(handle, tail + offset);
+
+  return SL_STATUS_OK;
+}
+
+// remove
+sl_status_t ring_buffer_remove( ring_buffer_handle_t* handle, uint32_t offset)
+{
+  uint32_t head, tail;
+
+  CHECK_NULL(handle);
+
+  head = atomic_load_explicit(&handle->head, memory_order_relaxed);
+  tail = atomic_load_explicit(&handle->tail, memory_order_acquire);
+
+  // the oldest entry may be in use by the consumer
+  if( (offset == 0) || (offset >= _ring_buffer_count(head, tail)) )
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  // close the gap by moving every newer entry down one slot
+  for(uint32_t index = tail + offset; (index + 1) != head; index++)
+  {
+      memcpy(_ring_buffer_slot(handle, index), _ring_buffer_slot(handle, index + 1), handle->size);
+  }
+
+  atomic_store_explicit(&handle->head, head - 1, memory_order_release);
 
   return SL_STATUS_OK;
 }
@@ -36,27 +36,143 @@
 #ifndef RING_BUFFER_H_
 #define RING_BUFFER_H_
 
+#include <stdint.h>
+#include <stdatomic.h>
+
 #include "sl_status.h"
 
+// The ring buffer is lock-free for a single producer and a single consumer.
+// The producer is the only writer of head, the consumer the only writer of
+// tail. Each side publishes its index with release ordering and reads the
+// other side's index with acquire ordering, so a slot is never read before
+// its contents are visible nor overwritten before it has been consumed.
+//
+// head and tail are kept on separate cache lines on targets that have a data
+// cache to avoid false sharing. Cortex-M parts have none, the size is 0 there
+// and _Alignas(0) has no effect (C11 6.7.5), so the handle stays packed.
+#ifndef RING_BUFFER_CACHE_LINE_SIZE
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+#define RING_BUFFER_CACHE_LINE_SIZE   64
+#else
+#define RING_BUFFER_CACHE_LINE_SIZE   0
+#endif
+#endif
+
 typedef struct {
-  const uint32_t*   buffer;     // pointer to the buffer
-        uint32_t    head;       // index the producer writes to
-        uint32_t    tail;       // index the consumer reads from
+  void* const       buffer;     // pointer to the contiguous entry storage
   const uint32_t    size;       // size of datatype
   const uint32_t    capacity;   // max number of entries
+  _Alignas(RING_BUFFER_CACHE_LINE_SIZE)
+  _Atomic uint32_t  head;       // index the producer writes to
+  _Alignas(RING_BUFFER_CACHE_LINE_SIZE)
+  _Atomic uint32_t  tail;       // index the consumer reads from
 } ring_buffer_handle_t;
 
-// init
+// RING_BUFFER_DEFINE(name, type, num_entries)
+//
+// Defines a file local ring buffer of `num_entries` entries of `type` backed
+// by a statically initialized contiguous array, no runtime setup is needed.
+// Generates:
+//   name           ring_buffer_handle_t usable with the generic API below
+//   name##_add     typed add, producer only
+//   name##_get     typed get, consumer only
+// The typed functions are inlined and index the array directly with a
+// compile time mask, which is why num_entries must be a power of two.
+#define RING_BUFFER_DEFINE(name, type, num_entries)                             \
+  _Static_assert(((num_entries) > 0) &&                                         \
+                 (((num_entries) & ((num_entries) - 1)) == 0),                  \
+                 #name " capacity must be a power of two");                     \
+                                                                                \
+  static type                 name##_buffer[num_entries];                       \
+                                                                                \
+  static ring_buffer_handle_t name = {                                          \
+      .buffer   = name##_buffer,                                                \
+      .size     = sizeof(type),                                                 \
+      .capacity = (num_entries),                                                \
+      .head     = 0,                                                            \
+      .tail     = 0,                                                            \
+  };                                                                            \
+                                                                                \
+  static inline sl_status_t name##_add(const type* data)                        \
+  {                                                                             \
+    uint32_t head = atomic_load_explicit(&name.head, memory_order_relaxed);     \
+    uint32_t tail = atomic_load_explicit(&name.tail, memory_order_acquire);     \
+                                                                                \
+    if((head - tail) == (num_entries))                                          \
+    {                                                                           \
+        return SL_STATUS_FULL;                                                  \
+    }                                                                           \
+                                                                                \
+    name##_buffer[head & ((num_entries) - 1)] = *data;                          \
+    atomic_store_explicit(&name.head, head + 1, memory_order_release);          \
+                                                                                \
+    return SL_STATUS_OK;                                                        \
+  }                                                                             \
+                                                                                \
+  static inline sl_status_t name##_get(type* data)                              \
+  {                                                                             \
+    uint32_t tail = atomic_load_explicit(&name.tail, memory_order_relaxed);     \
+    uint32_t head = atomic_load_explicit(&name.head, memory_order_acquire);     \
+                                                                                \
+    if(head == tail)                                                            \
+    {                                                                           \
+        return SL_STATUS_EMPTY;                                                 \
+    }                                                                           \
+                                                                                \
+    *data = name##_buffer[tail & ((num_entries) - 1)];                          \
+    atomic_store_explicit(&name.tail, tail + 1, memory_order_release);          \
+                                                                                \
+    return SL_STATUS_OK;                                                        \
+  }
+
+// init, must not race with the producer or consumer
 sl_status_t ring_buffer_init( ring_buffer_handle_t* handle);
 
-// reset
+// reset, must not race with the producer or consumer
 sl_status_t ring_buffer_reset( ring_buffer_handle_t* handle);
 
-// add
+// add, producer only
 sl_status_t ring_buffer_add( ring_buffer_handle_t* handle, void* data);
 
-// get
+// get, consumer only
 sl_status_t ring_buffer_get( ring_buffer_handle_t* handle, void* data);
 
+// add_n, producer only. adds up to count entries from data, returns the
+// number of entries added
+uint32_t    ring_buffer_add_n( ring_buffer_handle_t* handle, const void* data, uint32_t count);
+
+// get_n, consumer only. gets up to count entries into data, returns the
+// number of entries read
+uint32_t    ring_buffer_get_n( ring_buffer_handle_t* handle, void* data, uint32_t count);
+
+// reserve, producer only. points slot at the free entry @ head so it can be
+// filled in place, the entry becomes visible to the consumer on commit
+sl_status_t ring_buffer_reserve( ring_buffer_handle_t* handle, void** slot);
+
+// commit, producer only. publishes the entry returned by reserve
+sl_status_t ring_buffer_commit( ring_buffer_handle_t* handle);
+
+// peek, consumer only. points slot at the oldest entry without copying it,
+// the entry stays valid until release
+sl_status_t ring_buffer_peek( ring_buffer_handle_t* handle, void** slot);
+
+// release, consumer only. hands the entry returned by peek back to the producer
+sl_status_t ring_buffer_release( ring_buffer_handle_t* handle);
+
+// count, number of queued entries
+uint32_t    ring_buffer_count( ring_buffer_handle_t* handle);
+
+// entry, producer only. points slot at the queued entry offset places after
+// the oldest one
+sl_status_t ring_buffer_entry( ring_buffer_handle_t* handle, uint32_t offset, void** slot);
+
+// remove, producer only. removes the queued entry offset places after the
+// oldest one and shifts the newer entries down. Unlike the rest of the API it
+// is not lock-free: the consumer must not run during the call, so call it
+// from the consumer's context or with the consumer's interrupt masked. A
+// consumer between peek and release may hold the oldest entry, offset 0 is
+// refused
+sl_status_t ring_buffer_remove( ring_buffer_handle_t* handle, uint32_t offset);
+
 
 #endif /* RING_BUFFER_H_ */
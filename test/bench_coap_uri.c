@@ -0,0 +1,234 @@
+/***************************************************************************//**
+ * @file
+ * @brief CoAP Request Build Benchmark
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <string.h>
+
+#include "coap_uri.h"
+#include "test_util.h"
+
+// per click cost of building the click request, with the Uri-Path parsed on
+// every send as otCoapMessageAppendUriPathOptions does, with the segments of
+// coap_uri_split, and with a header-plus-options prefix copied and patched.
+// OpenThread isn't built on the host, the message below encodes the header
+// and options the way its Coap::Message does into a flat buffer. message
+// allocation, the larger cost on the target, isn't part of any variant
+#define ROUNDS          2000000u
+#define URI_PATH        "question/answer"
+#define TOKEN_LENGTH    2
+#define PAYLOAD_LENGTH  20
+#define OPTION_URI_PATH 11
+
+typedef struct {
+  uint8_t   bytes[64];
+  uint16_t  length;
+  uint16_t  last_option;
+} message_t;
+
+static uint32_t           token_state;
+static coap_uri_segment_t segments[COAP_URI_MAX_SEGMENTS];
+static uint8_t            segment_count;
+static message_t          prefix;
+static volatile uint32_t  sink;
+
+static void message_init(message_t* message)
+{
+  message->bytes[0]     = 0x40;       // version 1, confirmable, no token yet
+  message->bytes[1]     = 0x02;       // POST
+  message->bytes[2]     = 0x12;
+  message->bytes[3]     = 0x34;
+  message->length       = 4;
+  message->last_option  = 0;
+}
+
+static void message_token(message_t* message)
+{
+  token_state = (token_state * 1664525u) + 1013904223u;
+
+  message->bytes[0] = (uint8_t) ((message->bytes[0] & 0xf0) | TOKEN_LENGTH);
+  message->bytes[4] = (uint8_t) (token_state >> 24);
+  message->bytes[5] = (uint8_t) (token_state >> 16);
+  message->length  += TOKEN_LENGTH;
+}
+
+// RFC 7252 3.1 option delta and length, extended past 12
+static uint8_t option_nibble(uint16_t value, uint8_t* extended, uint8_t* extended_length)
+{
+  if(value < 13)
+  {
+      *extended_length = 0;
+      return (uint8_t) value;
+  }
+
+  if(value < 269)
+  {
+      extended[(*extended_length)++] = (uint8_t) (value - 13);
+      return 13;
+  }
+
+  extended[(*extended_length)++] = (uint8_t) ((value - 269) >> 8);
+  extended[(*extended_length)++] = (uint8_t) (value - 269);
+  return 14;
+}
+
+static void message_append_option(message_t* message, uint16_t number, uint16_t length, const void* value)
+{
+  uint8_t extended[4];
+  uint8_t delta_length  = 0;
+  uint8_t length_length = 0;
+  uint8_t header;
+
+  header  = (uint8_t) (option_nibble(number - message->last_option, extended, &delta_length) << 4);
+  header |= option_nibble(length, &extended[delta_length], &length_length);
+
+  message->bytes[message->length++] = header;
+  memcpy(&message->bytes[message->length], extended, delta_length + length_length);
+  message->length += delta_length + length_length;
+  memcpy(&message->bytes[message->length], value, length);
+  message->length += length;
+  message->last_option = number;
+}
+
+// what otCoapMessageAppendUriPathOptions does with the path on every call
+static void message_append_uri_path(message_t* message, const char* path)
+{
+  const char* end;
+
+  while((end = strchr(path, '/')) != NULL)
+  {
+      message_append_option(message, OPTION_URI_PATH, (uint16_t) (end - path), path);
+      path = end + 1;
+  }
+
+  message_append_option(message, OPTION_URI_PATH, (uint16_t) strlen(path), path);
+}
+
+static void message_append_payload(message_t* message, const uint8_t* payload)
+{
+  message->bytes[message->length++] = 0xff;
+  memcpy(&message->bytes[message->length], payload, PAYLOAD_LENGTH);
+  message->length += PAYLOAD_LENGTH;
+}
+
+static void build_parsed(message_t* message, const uint8_t* payload)
+{
+  message_init(message);
+  message_token(message);
+  message_append_uri_path(message, URI_PATH);
+  message_append_payload(message, payload);
+}
+
+static void build_split(message_t* message, const uint8_t* payload)
+{
+  message_init(message);
+  message_token(message);
+
+  for(uint8_t i = 0; i < segment_count; i++)
+  {
+      message_append_option(message, OPTION_URI_PATH, segments[i].length, segments[i].value);
+  }
+
+  message_append_payload(message, payload);
+}
+
+// the prefix is built with a zero token, only the token is patched
+static void build_prefix(message_t* message, const uint8_t* payload)
+{
+  memcpy(message, &prefix, sizeof(*message));
+
+  token_state = (token_state * 1664525u) + 1013904223u;
+  message->bytes[4] = (uint8_t) (token_state >> 24);
+  message->bytes[5] = (uint8_t) (token_state >> 16);
+
+  message_append_payload(message, payload);
+}
+
+static double bench(void (*build)(message_t*, const uint8_t*), message_t* last)
+{
+  message_t message;
+  uint8_t   payload[PAYLOAD_LENGTH] = { 2 };
+  uint64_t  start;
+
+  token_state = 1;
+  start       = test_now_ns();
+
+  for(uint32_t round = 0; round < ROUNDS; round++)
+  {
+      payload[11] = (uint8_t) round;
+      build(&message, payload);
+      sink += message.bytes[message.length - 1];
+  }
+
+  *last = message;
+
+  return (double) (test_now_ns() - start) / ROUNDS;
+}
+
+int main(void)
+{
+  message_t parsed;
+  message_t split;
+  message_t copied;
+  double    parsed_ns;
+  double    split_ns;
+  double    copied_ns;
+
+  CHECK_EQ(coap_uri_split(URI_PATH, segments, &segment_count), SL_STATUS_OK);
+  CHECK_EQ(segment_count, 2);
+  CHECK_EQ(coap_uri_split("a/b/c/d/e", segments, &segment_count), SL_STATUS_FULL);
+  CHECK_EQ(coap_uri_split(URI_PATH, segments, &segment_count), SL_STATUS_OK);
+
+  message_init(&prefix);
+  message_token(&prefix);
+  prefix.bytes[4] = 0;
+  prefix.bytes[5] = 0;
+  message_append_uri_path(&prefix, URI_PATH);
+
+  parsed_ns = bench(build_parsed, &parsed);
+  split_ns  = bench(build_split, &split);
+  copied_ns = bench(build_prefix, &copied);
+
+  printf("click request of %u bytes\n", parsed.length);
+  printf("parse the path per send: %6.2f ns/click\n", parsed_ns);
+  printf("segments split at init:  %6.2f ns/click (%+.2f)\n", split_ns, split_ns - parsed_ns);
+  printf("copied prefix:           %6.2f ns/click (%+.2f)\n", copied_ns, copied_ns - parsed_ns);
+
+  // the same bytes whichever way they were built
+  CHECK_EQ(split.length, parsed.length);
+  CHECK_EQ(copied.length, parsed.length);
+  CHECK(memcmp(split.bytes, parsed.bytes, parsed.length) == 0);
+  CHECK(memcmp(copied.bytes, parsed.bytes, parsed.length) == 0);
+
+  return TEST_RESULT();
+}
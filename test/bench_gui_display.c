@@ -0,0 +1,150 @@
+/***************************************************************************//**
+ * @file
+ * @brief GUI Display Raster Host Benchmark
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <string.h>
+
+#include "glib.h"
+#include "gui_display.h"
+#include "host_display.h"
+#include "raster_ref.h"
+#include "test_util.h"
+
+// word-wise raster calls against the per pixel path GLIB takes, on the
+// rectangles the GUI draws. host numbers, they only compare the two paths
+#define ROUNDS    20000u
+
+typedef struct {
+  const char*     name;
+  raster_ref_op_t op;
+  int32_t         x_min, y_min, x_max, y_max;
+} bench_rect_t;
+
+static const bench_rect_t rects[] = {
+    { "clear panel",     RASTER_REF_FILL_WHITE,   0,   0, 127, 127 },
+    { "log window",      RASTER_REF_RESTORE,      0,  55, 127,  98 },
+    { "log line",        RASTER_REF_RESTORE,      0,  89, 127,  98 },
+    { "button invert",   RASTER_REF_INVERT,       2, 114,  61, 125 },
+    { "glyph cell",      RASTER_REF_RESTORE,     44,  34,  49,  41 },
+    { "divider",         RASTER_REF_FILL_BLACK,   0,  54, 127,  54 },
+};
+
+static uint8_t        background[HOST_DISPLAY_BYTES];
+static GLIB_Context_t glib_context;
+
+static void render_glyph(char c, int32_t x, int32_t y)
+{
+  GLIB_drawChar(&glib_context, c, x, y, false);
+}
+
+// a log line worth of glyphs, across the word boundaries
+static double bench_glyph(bool blit)
+{
+  static const char text[] = "[joiner] searching...";
+  uint64_t          start  = test_now_ns();
+
+  for(uint32_t round = 0; round < ROUNDS; round++)
+  {
+      for(uint32_t i = 0; i < sizeof(text) - 1; i++)
+      {
+          if(blit)
+          {
+              gui_display_draw_glyph(text[i], 2 + (i * 6), 90, GUI_DISPLAY_BLACK);
+          }
+          else
+          {
+              render_glyph(text[i], 2 + (i * 6), 90);
+          }
+      }
+  }
+
+  return (double) (test_now_ns() - start) / (ROUNDS * (sizeof(text) - 1));
+}
+
+static double bench_kernel(const bench_rect_t* rect)
+{
+  uint64_t start = test_now_ns();
+
+  for(uint32_t round = 0; round < ROUNDS; round++)
+  {
+      raster_ref_kernel(rect->op, rect->x_min, rect->y_min, rect->x_max, rect->y_max);
+  }
+
+  return (double) (test_now_ns() - start) / ROUNDS;
+}
+
+static double bench_reference(const bench_rect_t* rect)
+{
+  uint8_t* framebuffer = host_display_framebuffer();
+  uint64_t start       = test_now_ns();
+
+  for(uint32_t round = 0; round < ROUNDS; round++)
+  {
+      raster_ref_rect(framebuffer, background, rect->op, rect->x_min, rect->y_min, rect->x_max, rect->y_max);
+  }
+
+  return (double) (test_now_ns() - start) / ROUNDS;
+}
+
+int main(void)
+{
+  double kernel, reference;
+
+  host_display_reset(HOST_DISPLAY_FRAMEBUFFERS);
+  CHECK_EQ(gui_display_init(), SL_STATUS_OK);
+
+  raster_ref_pattern(background, 1);
+  memcpy(host_display_framebuffer(), background, HOST_DISPLAY_BYTES);
+  CHECK_EQ(gui_display_capture_background(), SL_STATUS_OK);
+
+  for(uint32_t i = 0; i < sizeof(rects) / sizeof(rects[0]); i++)
+  {
+      kernel    = bench_kernel(&rects[i]);
+      reference = bench_reference(&rects[i]);
+
+      printf("%-16s word %8.1f ns  per pixel %9.1f ns  x%.1f\n",
+             rects[i].name, kernel, reference, reference / kernel);
+  }
+
+  GLIB_contextInit(&glib_context);
+  CHECK_EQ(gui_display_capture_font(glib_context.font.fontWidth, glib_context.font.fontHeight, render_glyph),
+           SL_STATUS_OK);
+
+  kernel    = bench_glyph(true);
+  reference = bench_glyph(false);
+
+  printf("%-16s word %8.1f ns  per pixel %9.1f ns  x%.1f\n", "glyph", kernel, reference, reference / kernel);
+
+  return TEST_RESULT();
+}
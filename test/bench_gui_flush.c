@@ -0,0 +1,93 @@
+/***************************************************************************//**
+ * @file
+ * @brief GUI Display Flush Benchmark
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <string.h>
+
+#include "gui_display.h"
+#include "host_display.h"
+#include "test_util.h"
+
+// Time the main loop spends in one gui_display_process pass while a full
+// frame redraw goes out, with the SPI transfer time of the panel simulated
+// by the host display. Built once with the default GUI_DISPLAY_ROWS_PER_PROCESS
+// and once with the whole panel per pass, which is the blocking flush the
+// chunked one replaced.
+
+// address, 16 pixel bytes and dummy byte per row at the 1.1 MHz SPI clock of
+// the memory LCD
+#define ROW_TIME_NS   131000u
+#define FRAMES        8
+
+int main(void)
+{
+  const uint32_t  passes_per_frame = (GUI_DISPLAY_HEIGHT + GUI_DISPLAY_ROWS_PER_PROCESS - 1) / GUI_DISPLAY_ROWS_PER_PROCESS;
+  uint64_t        start, pass, worst = 0, total = 0;
+  uint32_t        passes;
+
+  host_display_reset(HOST_DISPLAY_FRAMEBUFFERS);
+  CHECK_EQ(gui_display_init(), SL_STATUS_OK);
+  host_display_set_row_time(ROW_TIME_NS);
+
+  for(uint32_t frame = 0; frame < FRAMES; frame++)
+  {
+      gui_display_fill_rect(0, 0, GUI_DISPLAY_WIDTH - 1, GUI_DISPLAY_HEIGHT - 1,
+                            (frame & 1) ? GUI_DISPLAY_BLACK : GUI_DISPLAY_WHITE);
+      CHECK_EQ(gui_display_flush_start(NULL), SL_STATUS_OK);
+
+      for(passes = 0; gui_display_is_busy() && (passes < GUI_DISPLAY_HEIGHT); passes++)
+      {
+          start = test_now_ns();
+          gui_display_process();
+          pass  = test_now_ns() - start;
+
+          total += pass;
+          if(pass > worst)
+          {
+              worst = pass;
+          }
+      }
+
+      CHECK_EQ(passes, passes_per_frame);
+      CHECK_EQ(memcmp(host_display_panel(), gui_display_get_framebuffer(), HOST_DISPLAY_BYTES), 0);
+  }
+
+  // a pass can't be shorter than the rows it sends
+  CHECK(worst >= ((uint64_t) GUI_DISPLAY_ROWS_PER_PROCESS * ROW_TIME_NS));
+
+  printf("rows per pass %3u  passes per frame %3u  worst pass %8.1f us  frame %8.1f us\n",
+         GUI_DISPLAY_ROWS_PER_PROCESS, passes_per_frame, worst / 1000.0, total / 1000.0 / FRAMES);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,114 @@
+/***************************************************************************//**
+ * @file
+ * @brief GUI Log Benchmark
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <string.h>
+
+#include "gui.h"
+#include "gui_display.h"
+#include "host_display.h"
+#include "test_util.h"
+
+// Glyphs rasterized and time spent per log message. Built for several
+// LOG_VISIBLE_LINES / LOG_BUFFER_LEN pairs, the cost must not depend on
+// either. The redraw the scroll replaced drew every visible line again.
+#define MESSAGES  2000u
+
+static const char* const lines[] = {
+    "[joiner] searching...",
+    "[coap] tx 'A'",
+    "[coap] click 12 lost",
+    "hello :)",
+};
+
+static uint32_t glyphs_drawn(void)
+{
+  gui_display_stats_t stats;
+
+  gui_display_get_stats(&stats);
+
+  return stats.glyphs;
+}
+
+int main(void)
+{
+  uint32_t  glyphs  = 0;
+  uint32_t  longest = 0;
+  uint32_t  drawn;
+  uint64_t  start, elapsed;
+  size_t    length;
+
+  host_display_reset(HOST_DISPLAY_FRAMEBUFFERS);
+  CHECK_EQ(gui_init(), SL_STATUS_OK);
+
+  start = test_now_ns();
+
+  for(uint32_t i = 0; i < MESSAGES; i++)
+  {
+      drawn = glyphs_drawn();
+      gui_print_log(lines[i % 4]);
+      drawn = glyphs_drawn() - drawn;
+
+      length = strlen(lines[i % 4]);
+      if(length > DISPLAY_LOG_MAX_STR_LEN)
+      {
+          length = DISPLAY_LOG_MAX_STR_LEN;
+      }
+
+      // only the new line is drawn
+      CHECK_EQ(drawn, length);
+      glyphs += drawn;
+
+      if(drawn > longest)
+      {
+          longest = drawn;
+      }
+  }
+
+  elapsed = test_now_ns() - start;
+
+  // the scrollback holds the newest lines, oldest last
+  for(uint32_t age = 0; age < LOG_BUFFER_LEN; age++)
+  {
+      CHECK(gui_get_log_line(age) != NULL);
+      CHECK_EQ(strncmp(gui_get_log_line(age), lines[(MESSAGES - 1 - age) % 4], DISPLAY_LOG_MAX_STR_LEN), 0);
+  }
+  CHECK(gui_get_log_line(LOG_BUFFER_LEN) == NULL);
+
+  printf("visible %2u  scrollback %2u  glyphs per message %5.1f  max %2u  full redraw %3u  %7.1f ns\n",
+         LOG_VISIBLE_LINES, LOG_BUFFER_LEN, (double) glyphs / MESSAGES, longest,
+         LOG_VISIBLE_LINES * DISPLAY_LOG_MAX_STR_LEN, (double) elapsed / MESSAGES);
+
+  return TEST_RESULT();
+}
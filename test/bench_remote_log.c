@@ -0,0 +1,155 @@
+/***************************************************************************//**
+ * @file
+ * @brief Remote Log Host Benchmark
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <stdarg.h>
+#include <string.h>
+
+#include "remote_log.h"
+#include "test_util.h"
+
+// logging cost of one click on the send path, before and after the binary
+// log. before, coap_client_send_message formatted the message length and the
+// destination address with printf and the response handler printed a line,
+// all of it written out while the click was being sent. after, the same
+// sites store two records and the frames go out later from
+// remote_log_process. host numbers, the serial port time is computed from the
+// bytes at 115200 baud, 8N1
+#define ROUNDS        200000u
+#define BAUD          115200u
+
+// clicks logged between two drains, two records each fill the ring
+#define BURST         (REMOTE_LOG_RING_LEN / 2)
+
+static volatile uint32_t  sink;
+static uint32_t           bytes;
+
+void _putchar(char character)
+{
+  sink += (uint8_t) character;
+  bytes++;
+}
+
+// the embedded printf, one _putchar per character
+static void target_printf(const char* format, ...)
+{
+  char    line[96];
+  va_list args;
+  int     length;
+
+  va_start(args, format);
+  length = vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+
+  for(int i = 0; (i < length) && (i < (int) sizeof(line)); i++)
+  {
+      _putchar(line[i]);
+  }
+}
+
+// otIp6AddressToString
+static void address_to_string(const uint16_t* groups, char* out, size_t size)
+{
+  snprintf(out, size, "%x:%x:%x:%x:%x:%x:%x:%x", groups[0], groups[1], groups[2], groups[3],
+           groups[4], groups[5], groups[6], groups[7]);
+}
+
+static const uint16_t rloc[8]   = { 0xfd5d, 0x8e40, 0x1b0d, 0x73a2, 0x0000, 0x00ff, 0xfe00, 0xfc00 };
+static const char     message[] = "00:0B:57:64:8D:1A A";
+
+static void click_before(void)
+{
+  char address[48];
+
+  target_printf("message to append: %s, len: %d\r\n", message, (int) strlen(message));
+  address_to_string(rloc, address, sizeof(address));
+  target_printf("sending '%s' to %s\r\n", message, address);
+  target_printf("coap client handler\r\n");
+}
+
+static void click_after(void)
+{
+  REMOTE_LOG_INFO(REMOTE_LOG_COAP_TX, 20, rloc[7]);
+  REMOTE_LOG_INFO(REMOTE_LOG_COAP_RESPONSE, 0);
+}
+
+int main(void)
+{
+  uint64_t  start;
+  double    before, after, drain;
+  uint32_t  before_bytes, after_bytes;
+
+  bytes = 0;
+  start = test_now_ns();
+  for(uint32_t round = 0; round < ROUNDS; round++)
+  {
+      click_before();
+  }
+  before        = (double) (test_now_ns() - start) / ROUNDS;
+  before_bytes  = bytes / ROUNDS;
+
+  after = 0;
+  drain = 0;
+  bytes = 0;
+  for(uint32_t round = 0; round < ROUNDS; round += BURST)
+  {
+      start = test_now_ns();
+      for(uint32_t i = 0; i < BURST; i++)
+      {
+          click_after();
+      }
+      after += (double) (test_now_ns() - start);
+
+      // later, from the main loop
+      start = test_now_ns();
+      for(uint32_t i = 0; i < (REMOTE_LOG_RING_LEN / REMOTE_LOG_RECORDS_PER_PROCESS); i++)
+      {
+          remote_log_process();
+      }
+      drain += (double) (test_now_ns() - start);
+  }
+  after       /= ROUNDS;
+  drain       /= ROUNDS;
+  after_bytes  = bytes / ROUNDS;
+
+  CHECK_EQ(remote_log_get_dropped(), 0);
+
+  printf("printf at the click    %7.1f ns  %3u bytes  %6.0f us on the port\n",
+         before, before_bytes, (before_bytes * 10.0 * 1e6) / BAUD);
+  printf("records at the click   %7.1f ns\n", after);
+  printf("frames from the loop   %7.1f ns  %3u bytes  %6.0f us on the port\n",
+         drain, after_bytes, (after_bytes * 10.0 * 1e6) / BAUD);
+
+  return TEST_RESULT();
+}
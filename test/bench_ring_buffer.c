@@ -0,0 +1,193 @@
+/***************************************************************************//**
+ * @file
+ * @brief Ring Buffer Copy Benchmark
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+
+#include "ring_buffer.h"
+#include "gui_event_queue.h"
+#include "test_util.h"
+
+// per event cost of the ways a GUI event can travel through a ring, in bursts
+// of BURST events like an attach produces. host numbers, they only compare
+// the variants with each other
+#define BURST         8
+#define ROUNDS        2000000u
+
+// the event before the typed payloads, preformatted text
+typedef struct {
+  uint32_t  flag;
+  char      msg[32];
+} legacy_event_t;
+
+RING_BUFFER_DEFINE(legacy_ring, legacy_event_t, BURST)
+RING_BUFFER_DEFINE(event_ring,  gui_event_t,    BURST)
+
+static volatile uint32_t sink;
+
+// stands in for the renderer reading the payload
+static inline void consume(const void* data, uint32_t size)
+{
+  const uint8_t* bytes = data;
+  uint32_t       sum   = 0;
+
+  for(uint32_t i = 0; i < size; i++)
+  {
+      sum += bytes[i];
+  }
+
+  sink += sum;
+}
+
+static double bench_legacy(void)
+{
+  legacy_event_t  event;
+  uint64_t        start = test_now_ns();
+
+  for(uint32_t round = 0; round < ROUNDS; round++)
+  {
+      for(uint32_t i = 0; i < BURST; i++)
+      {
+          event.flag = GUI_EVENT_FLAG_NTWK_CH;
+          snprintf(event.msg, sizeof(event.msg), "%u", (unsigned) (round + i) % 27);
+          ring_buffer_add(&legacy_ring, &event);
+      }
+
+      for(uint32_t i = 0; i < BURST; i++)
+      {
+          ring_buffer_get(&legacy_ring, &event);
+          consume(&event, sizeof(event));
+      }
+  }
+
+  return (double) (test_now_ns() - start) / (ROUNDS * BURST);
+}
+
+static double bench_add_get(void)
+{
+  gui_event_t event;
+  uint64_t    start = test_now_ns();
+
+  for(uint32_t round = 0; round < ROUNDS; round++)
+  {
+      for(uint32_t i = 0; i < BURST; i++)
+      {
+          event.flag    = GUI_EVENT_FLAG_NTWK_CH;
+          event.channel = (uint8_t) ((round + i) % 27);
+          ring_buffer_add(&event_ring, &event);
+      }
+
+      for(uint32_t i = 0; i < BURST; i++)
+      {
+          ring_buffer_get(&event_ring, &event);
+          consume(&event, sizeof(event));
+      }
+  }
+
+  return (double) (test_now_ns() - start) / (ROUNDS * BURST);
+}
+
+static double bench_zero_copy(void)
+{
+  gui_event_t* slot;
+  uint64_t     start = test_now_ns();
+
+  for(uint32_t round = 0; round < ROUNDS; round++)
+  {
+      for(uint32_t i = 0; i < BURST; i++)
+      {
+          ring_buffer_reserve(&event_ring, (void **) &slot);
+          slot->flag    = GUI_EVENT_FLAG_NTWK_CH;
+          slot->channel = (uint8_t) ((round + i) % 27);
+          ring_buffer_commit(&event_ring);
+      }
+
+      for(uint32_t i = 0; i < BURST; i++)
+      {
+          ring_buffer_peek(&event_ring, (void **) &slot);
+          consume(slot, sizeof(*slot));
+          ring_buffer_release(&event_ring);
+      }
+  }
+
+  return (double) (test_now_ns() - start) / (ROUNDS * BURST);
+}
+
+// the burst drained with one get_n instead of a get per event
+static double bench_get_n(void)
+{
+  gui_event_t event;
+  gui_event_t burst[BURST];
+  uint64_t    start = test_now_ns();
+
+  for(uint32_t round = 0; round < ROUNDS; round++)
+  {
+      for(uint32_t i = 0; i < BURST; i++)
+      {
+          event.flag    = GUI_EVENT_FLAG_NTWK_CH;
+          event.channel = (uint8_t) ((round + i) % 27);
+          ring_buffer_add(&event_ring, &event);
+      }
+
+      ring_buffer_get_n(&event_ring, burst, BURST);
+
+      for(uint32_t i = 0; i < BURST; i++)
+      {
+          consume(&burst[i], sizeof(burst[i]));
+      }
+  }
+
+  return (double) (test_now_ns() - start) / (ROUNDS * BURST);
+}
+
+int main(void)
+{
+  double legacy    = bench_legacy();
+  double add_get   = bench_add_get();
+  double zero_copy = bench_zero_copy();
+  double get_n     = bench_get_n();
+
+  printf("event size: legacy %zu bytes, typed %zu bytes\n", sizeof(legacy_event_t), sizeof(gui_event_t));
+  printf("legacy snprintf + add/get:   %6.2f ns/event\n", legacy);
+  printf("typed add/get:               %6.2f ns/event\n", add_get);
+  printf("typed reserve/commit + peek: %6.2f ns/event (%+.2f vs add/get)\n", zero_copy, zero_copy - add_get);
+  printf("typed add + get_n burst:     %6.2f ns/event (%+.2f vs add/get)\n", get_n, get_n - add_get);
+
+  // both paths have to move every event through
+  CHECK_EQ(ring_buffer_count(&event_ring), 0);
+  CHECK_EQ(ring_buffer_count(&legacy_ring), 0);
+
+  return TEST_RESULT();
+}
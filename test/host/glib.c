@@ -0,0 +1,192 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host GLIB Subset
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <string.h>
+
+#include "glib.h"
+#include "host_display.h"
+
+#define FONT_FIRST_CHAR   0x20
+#define FONT_LAST_CHAR    0x7e
+#define FONT_COLUMNS      5
+
+// classic 5x7 font, one byte per column, bit 0 is the top row
+static const uint8_t font_5x7[FONT_LAST_CHAR - FONT_FIRST_CHAR + 1][FONT_COLUMNS] = {
+  {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5f, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00}, // ' ' ! "
+  {0x14, 0x7f, 0x14, 0x7f, 0x14}, {0x24, 0x2a, 0x7f, 0x2a, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, // # $ %
+  {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00}, {0x00, 0x1c, 0x22, 0x41, 0x00}, // & ' (
+  {0x00, 0x41, 0x22, 0x1c, 0x00}, {0x2a, 0x1c, 0x7f, 0x1c, 0x2a}, {0x08, 0x08, 0x3e, 0x08, 0x08}, // ) * +
+  {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x00, 0x60, 0x60, 0x00}, // , - .
+  {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3e, 0x51, 0x49, 0x45, 0x3e}, {0x00, 0x42, 0x7f, 0x40, 0x00}, // / 0 1
+  {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4d, 0x33}, {0x18, 0x14, 0x12, 0x7f, 0x10}, // 2 3 4
+  {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3c, 0x4a, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07}, // 5 6 7
+  {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1e}, {0x00, 0x00, 0x14, 0x00, 0x00}, // 8 9 :
+  {0x00, 0x40, 0x34, 0x00, 0x00}, {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14}, // ; < =
+  {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06}, {0x3e, 0x41, 0x5d, 0x59, 0x4e}, // > ? @
+  {0x7c, 0x12, 0x11, 0x12, 0x7c}, {0x7f, 0x49, 0x49, 0x49, 0x36}, {0x3e, 0x41, 0x41, 0x41, 0x22}, // A B C
+  {0x7f, 0x41, 0x41, 0x41, 0x3e}, {0x7f, 0x49, 0x49, 0x49, 0x41}, {0x7f, 0x09, 0x09, 0x09, 0x01}, // D E F
+  {0x3e, 0x41, 0x41, 0x51, 0x73}, {0x7f, 0x08, 0x08, 0x08, 0x7f}, {0x00, 0x41, 0x7f, 0x41, 0x00}, // G H I
+  {0x20, 0x40, 0x41, 0x3f, 0x01}, {0x7f, 0x08, 0x14, 0x22, 0x41}, {0x7f, 0x40, 0x40, 0x40, 0x40}, // J K L
+  {0x7f, 0x02, 0x1c, 0x02, 0x7f}, {0x7f, 0x04, 0x08, 0x10, 0x7f}, {0x3e, 0x41, 0x41, 0x41, 0x3e}, // M N O
+  {0x7f, 0x09, 0x09, 0x09, 0x06}, {0x3e, 0x41, 0x51, 0x21, 0x5e}, {0x7f, 0x09, 0x19, 0x29, 0x46}, // P Q R
+  {0x26, 0x49, 0x49, 0x49, 0x32}, {0x03, 0x01, 0x7f, 0x01, 0x03}, {0x3f, 0x40, 0x40, 0x40, 0x3f}, // S T U
+  {0x1f, 0x20, 0x40, 0x20, 0x1f}, {0x3f, 0x40, 0x38, 0x40, 0x3f}, {0x63, 0x14, 0x08, 0x14, 0x63}, // V W X
+  {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x59, 0x49, 0x4d, 0x43}, {0x00, 0x7f, 0x41, 0x41, 0x41}, // Y Z [
+  {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7f}, {0x04, 0x02, 0x01, 0x02, 0x04}, // \ ] ^
+  {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40}, // _ ` a
+  {0x7f, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28}, {0x38, 0x44, 0x44, 0x28, 0x7f}, // b c d
+  {0x38, 0x54, 0x54, 0x54, 0x18}, {0x00, 0x08, 0x7e, 0x09, 0x02}, {0x18, 0xa4, 0xa4, 0x9c, 0x78}, // e f g
+  {0x7f, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7d, 0x40, 0x00}, {0x20, 0x40, 0x40, 0x3d, 0x00}, // h i j
+  {0x7f, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7f, 0x40, 0x00}, {0x7c, 0x04, 0x78, 0x04, 0x78}, // k l m
+  {0x7c, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0xfc, 0x18, 0x24, 0x24, 0x18}, // n o p
+  {0x18, 0x24, 0x24, 0x18, 0xfc}, {0x7c, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24}, // q r s
+  {0x04, 0x04, 0x3f, 0x44, 0x24}, {0x3c, 0x40, 0x40, 0x20, 0x7c}, {0x1c, 0x20, 0x40, 0x20, 0x1c}, // t u v
+  {0x3c, 0x40, 0x30, 0x40, 0x3c}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4c, 0x90, 0x90, 0x90, 0x7c}, // w x y
+  {0x44, 0x64, 0x54, 0x4c, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x77, 0x00, 0x00}, // z { |
+  {0x00, 0x41, 0x36, 0x08, 0x00}, {0x02, 0x01, 0x02, 0x04, 0x02},                                 // } ~
+};
+
+const GLIB_Font_t GLIB_FontNarrow6x8 = {
+    .pFontPixMap      = font_5x7,
+    .fontPixMapSize   = sizeof(font_5x7),
+    .cntOfMapElements = FONT_LAST_CHAR - FONT_FIRST_CHAR + 1,
+    .fontWidth        = 6,
+    .fontHeight       = 8,
+    .lineSpacing      = 2,
+    .charSpacing      = 0,
+};
+
+static void glib_pixel(GLIB_Context_t* context, int32_t x, int32_t y, uint32_t color)
+{
+  uint8_t* framebuffer = host_display_framebuffer();
+
+  if((framebuffer == NULL) ||
+     (x < context->clippingRegion.xMin) || (x > context->clippingRegion.xMax) ||
+     (y < context->clippingRegion.yMin) || (y > context->clippingRegion.yMax))
+  {
+      return;
+  }
+
+  host_display_set_pixel(framebuffer, x, y, color != Black);
+  host_display_counters.pixels++;
+}
+
+EMSTATUS GLIB_contextInit(GLIB_Context_t* context)
+{
+  context->backgroundColor  = White;
+  context->foregroundColor  = Black;
+  context->font             = GLIB_FontNarrow6x8;
+
+  context->clippingRegion.xMin = 0;
+  context->clippingRegion.yMin = 0;
+  context->clippingRegion.xMax = HOST_DISPLAY_WIDTH - 1;
+  context->clippingRegion.yMax = HOST_DISPLAY_HEIGHT - 1;
+
+  return DMD_OK;
+}
+
+EMSTATUS GLIB_drawRect(GLIB_Context_t* context, const GLIB_Rectangle_t* rect)
+{
+  for(int32_t x = rect->xMin; x <= rect->xMax; x++)
+  {
+      glib_pixel(context, x, rect->yMin, context->foregroundColor);
+      glib_pixel(context, x, rect->yMax, context->foregroundColor);
+  }
+
+  for(int32_t y = rect->yMin + 1; y < rect->yMax; y++)
+  {
+      glib_pixel(context, rect->xMin, y, context->foregroundColor);
+      glib_pixel(context, rect->xMax, y, context->foregroundColor);
+  }
+
+  return DMD_OK;
+}
+
+EMSTATUS GLIB_drawChar(GLIB_Context_t* context, char c, int32_t x, int32_t y, bool opaque)
+{
+  const uint8_t* glyph;
+  bool           set;
+
+  if((c < FONT_FIRST_CHAR) || (c > FONT_LAST_CHAR))
+  {
+      c = '?';
+  }
+
+  glyph = font_5x7[c - FONT_FIRST_CHAR];
+
+  for(int32_t col = 0; col < context->font.fontWidth; col++)
+  {
+      for(int32_t row = 0; row < context->font.fontHeight; row++)
+      {
+          set = (col < FONT_COLUMNS) && (glyph[col] & (1u << row));
+
+          if(set)
+          {
+              glib_pixel(context, x + col, y + row, context->foregroundColor);
+          }
+          else if(opaque)
+          {
+              glib_pixel(context, x + col, y + row, context->backgroundColor);
+          }
+      }
+  }
+
+  return DMD_OK;
+}
+
+EMSTATUS GLIB_drawStringOnLine(GLIB_Context_t* context, const char* str, uint8_t line,
+                               GLIB_Align_t align, int32_t xOffset, int32_t yOffset, bool opaque)
+{
+  int32_t pitch = context->font.fontWidth + context->font.charSpacing;
+  int32_t width = (int32_t) strlen(str) * pitch;
+  int32_t x     = xOffset;
+  int32_t y     = yOffset + (line * (context->font.fontHeight + context->font.lineSpacing));
+
+  if(align == GLIB_ALIGN_CENTER)
+  {
+      x += (HOST_DISPLAY_WIDTH - width) / 2;
+  }
+  else if(align == GLIB_ALIGN_RIGHT)
+  {
+      x += HOST_DISPLAY_WIDTH - width;
+  }
+
+  for(; *str != '\0'; str++, x += pitch)
+  {
+      GLIB_drawChar(context, *str, x, y, opaque);
+  }
+
+  return DMD_OK;
+}
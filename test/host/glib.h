@@ -0,0 +1,89 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host Stand-in for the GLIB Interface
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef GLIB_H_
+#define GLIB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dmd.h"
+
+// the subset of the graphics library gui.c uses, drawing into the framebuffer
+// selected through DMD. the font is a 5x7 ASCII font in a 6x8 cell with the
+// metrics of GLIB_FontNarrow6x8, so layouts match the target while the
+// glyphs themselves differ
+#define White   0xffffff
+#define Black   0x000000
+
+typedef struct {
+  int32_t   xMin;
+  int32_t   yMin;
+  int32_t   xMax;
+  int32_t   yMax;
+} GLIB_Rectangle_t;
+
+typedef struct {
+  const void*   pFontPixMap;
+  uint16_t      fontPixMapSize;
+  uint8_t       cntOfMapElements;
+  uint8_t       fontWidth;
+  uint8_t       fontHeight;
+  uint8_t       lineSpacing;
+  uint8_t       charSpacing;
+} GLIB_Font_t;
+
+typedef struct {
+  uint32_t          backgroundColor;
+  uint32_t          foregroundColor;
+  GLIB_Rectangle_t  clippingRegion;
+  GLIB_Font_t       font;
+} GLIB_Context_t;
+
+typedef enum {
+  GLIB_ALIGN_LEFT,
+  GLIB_ALIGN_CENTER,
+  GLIB_ALIGN_RIGHT,
+} GLIB_Align_t;
+
+extern const GLIB_Font_t GLIB_FontNarrow6x8;
+
+EMSTATUS GLIB_contextInit(GLIB_Context_t* context);
+EMSTATUS GLIB_drawRect(GLIB_Context_t* context, const GLIB_Rectangle_t* rect);
+EMSTATUS GLIB_drawChar(GLIB_Context_t* context, char c, int32_t x, int32_t y, bool opaque);
+EMSTATUS GLIB_drawStringOnLine(GLIB_Context_t* context, const char* str, uint8_t line,
+                               GLIB_Align_t align, int32_t xOffset, int32_t yOffset, bool opaque);
+
+#endif /* GLIB_H_ */
@@ -0,0 +1,307 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host Display Backend
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "dmd.h"
+#include "sl_memlcd.h"
+
+#include "host_display.h"
+
+host_display_counters_t   host_display_counters;
+
+static  uint8_t           pool[HOST_DISPLAY_FRAMEBUFFERS][HOST_DISPLAY_BYTES];
+static  uint32_t          pool_size;
+static  uint32_t          pool_used;
+static  uint8_t*          selected;
+static  bool              initialized;
+
+static  uint8_t           panel[HOST_DISPLAY_BYTES];
+static  uint32_t          draw_failures;
+static  uint32_t          row_time_ns;
+
+static  const sl_memlcd_t memlcd = {
+    .width  = HOST_DISPLAY_WIDTH,
+    .height = HOST_DISPLAY_HEIGHT,
+    .bpp    = 1,
+};
+
+static  DMD_DisplayGeometry geometry = {
+    .xSize      = HOST_DISPLAY_WIDTH,
+    .ySize      = HOST_DISPLAY_HEIGHT,
+    .xClipStart = 0,
+    .yClipStart = 0,
+    .clipWidth  = HOST_DISPLAY_WIDTH,
+    .clipHeight = HOST_DISPLAY_HEIGHT,
+};
+
+void host_display_reset(uint32_t framebuffers)
+{
+  memset(pool, 0, sizeof(pool));
+  memset(panel, 0, sizeof(panel));
+  memset(&host_display_counters, 0, sizeof(host_display_counters));
+
+  pool_size     = (framebuffers > HOST_DISPLAY_FRAMEBUFFERS) ? HOST_DISPLAY_FRAMEBUFFERS : framebuffers;
+  pool_used     = 0;
+  selected      = NULL;
+  initialized   = false;
+  draw_failures = 0;
+  row_time_ns   = 0;
+}
+
+void host_display_fail_draws(uint32_t count)
+{
+  draw_failures = count;
+}
+
+void host_display_set_row_time(uint32_t row_ns)
+{
+  row_time_ns = row_ns;
+}
+
+// busy wait, the main loop is held up the same way by a blocking transfer
+static void host_display_spin(uint64_t ns)
+{
+  struct timespec ts;
+  uint64_t        end;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  end = ((uint64_t) ts.tv_sec * 1000000000u) + (uint64_t) ts.tv_nsec + ns;
+
+  do
+  {
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+  } while((((uint64_t) ts.tv_sec * 1000000000u) + (uint64_t) ts.tv_nsec) < end);
+}
+
+const uint8_t* host_display_panel(void)
+{
+  return panel;
+}
+
+uint8_t* host_display_framebuffer(void)
+{
+  return selected;
+}
+
+bool host_display_get_pixel(const uint8_t* image, int32_t x, int32_t y)
+{
+  return (image[(y * HOST_DISPLAY_ROW_BYTES) + (x / 8)] & (1u << (x % 8))) != 0;
+}
+
+void host_display_set_pixel(uint8_t* image, int32_t x, int32_t y, bool white)
+{
+  uint8_t* byte = &image[(y * HOST_DISPLAY_ROW_BYTES) + (x / 8)];
+
+  if(white)
+  {
+      *byte |= (uint8_t) (1u << (x % 8));
+  }
+  else
+  {
+      *byte &= (uint8_t) ~(1u << (x % 8));
+  }
+}
+
+uint32_t host_display_diff(const uint8_t* a, const uint8_t* b)
+{
+  uint32_t differ = 0;
+
+  for(int32_t y = 0; y < HOST_DISPLAY_HEIGHT; y++)
+  {
+      for(int32_t x = 0; x < HOST_DISPLAY_WIDTH; x++)
+      {
+          differ += host_display_get_pixel(a, x, y) != host_display_get_pixel(b, x, y);
+      }
+  }
+
+  return differ;
+}
+
+// PBM rows are MSB first and a set bit is black
+int host_display_write_pbm(const char* path, const uint8_t* image)
+{
+  FILE*   file = fopen(path, "wb");
+  uint8_t row[HOST_DISPLAY_ROW_BYTES];
+
+  if(file == NULL)
+  {
+      return -1;
+  }
+
+  fprintf(file, "P4\n%d %d\n", HOST_DISPLAY_WIDTH, HOST_DISPLAY_HEIGHT);
+
+  for(int32_t y = 0; y < HOST_DISPLAY_HEIGHT; y++)
+  {
+      memset(row, 0, sizeof(row));
+
+      for(int32_t x = 0; x < HOST_DISPLAY_WIDTH; x++)
+      {
+          if(!host_display_get_pixel(image, x, y))
+          {
+              row[x / 8] |= (uint8_t) (0x80u >> (x % 8));
+          }
+      }
+
+      fwrite(row, 1, sizeof(row), file);
+  }
+
+  return fclose(file);
+}
+
+int host_display_read_pbm(const char* path, uint8_t* image)
+{
+  FILE*   file = fopen(path, "rb");
+  uint8_t row[HOST_DISPLAY_ROW_BYTES];
+  int     width, height;
+
+  if(file == NULL)
+  {
+      return -1;
+  }
+
+  if((fscanf(file, "P4 %d %d", &width, &height) != 2) || (fgetc(file) == EOF) ||
+     (width != HOST_DISPLAY_WIDTH) || (height != HOST_DISPLAY_HEIGHT))
+  {
+      fclose(file);
+      return -1;
+  }
+
+  for(int32_t y = 0; y < HOST_DISPLAY_HEIGHT; y++)
+  {
+      if(fread(row, 1, sizeof(row), file) != sizeof(row))
+      {
+          fclose(file);
+          return -1;
+      }
+
+      for(int32_t x = 0; x < HOST_DISPLAY_WIDTH; x++)
+      {
+          host_display_set_pixel(image, x, y, (row[x / 8] & (0x80u >> (x % 8))) == 0);
+      }
+  }
+
+  fclose(file);
+
+  return 0;
+}
+
+// DMD, like the memory LCD driver DMD_init takes a framebuffer from the pool
+EMSTATUS DMD_init(DMD_InitConfig* config)
+{
+  (void) config;
+
+  if(pool_used == pool_size)
+  {
+      return DMD_ERROR_NO_FRAMEBUFFER;
+  }
+
+  selected    = pool[pool_used++];
+  initialized = true;
+
+  return DMD_OK;
+}
+
+EMSTATUS DMD_getDisplayGeometry(DMD_DisplayGeometry** out)
+{
+  if(!initialized)
+  {
+      return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  *out = &geometry;
+
+  return DMD_OK;
+}
+
+EMSTATUS DMD_allocateFramebuffer(void** framebuffer)
+{
+  if(pool_used == pool_size)
+  {
+      return DMD_ERROR_NO_FRAMEBUFFER;
+  }
+
+  *framebuffer = pool[pool_used++];
+
+  return DMD_OK;
+}
+
+EMSTATUS DMD_selectFramebuffer(void* framebuffer)
+{
+  if(!initialized)
+  {
+      return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  selected = framebuffer;
+
+  return DMD_OK;
+}
+
+// memory LCD
+const sl_memlcd_t* sl_memlcd_get(void)
+{
+  return &memlcd;
+}
+
+sl_status_t sl_memlcd_draw(const sl_memlcd_t* device, const void* data, unsigned int row_start, unsigned int row_count)
+{
+  if((device != &memlcd) || ((row_start + row_count) > HOST_DISPLAY_HEIGHT))
+  {
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  if(draw_failures > 0)
+  {
+      draw_failures--;
+      return SL_STATUS_FAIL;
+  }
+
+  memcpy(&panel[row_start * HOST_DISPLAY_ROW_BYTES], data, row_count * HOST_DISPLAY_ROW_BYTES);
+
+  if(row_time_ns > 0)
+  {
+      host_display_spin((uint64_t) row_count * row_time_ns);
+  }
+
+  // command byte, address and dummy byte per row, trailing dummy byte
+  host_display_counters.transfers++;
+  host_display_counters.rows  += row_count;
+  host_display_counters.bytes += 2 + (row_count * (HOST_DISPLAY_ROW_BYTES + 2));
+
+  return SL_STATUS_OK;
+}
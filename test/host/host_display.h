@@ -0,0 +1,89 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host Display Backend Header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef HOST_DISPLAY_H_
+#define HOST_DISPLAY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// In-memory stand-in for the memory LCD and the DMD/GLIB layers above it.
+// GLIB draws into the framebuffer selected through DMD, sl_memlcd_draw copies
+// rows from it into a separate panel image, so a test sees exactly what
+// reached the display. Images use the framebuffer layout, pixel x of a row is
+// bit (x % 8) of byte (x / 8) and a set bit is white.
+#define HOST_DISPLAY_WIDTH        128
+#define HOST_DISPLAY_HEIGHT       128
+#define HOST_DISPLAY_ROW_BYTES    (HOST_DISPLAY_WIDTH / 8)
+#define HOST_DISPLAY_BYTES        (HOST_DISPLAY_HEIGHT * HOST_DISPLAY_ROW_BYTES)
+
+// framebuffers the DMD pool holds by default, DMD_init takes one of them
+#define HOST_DISPLAY_FRAMEBUFFERS 2
+
+typedef struct {
+  uint32_t  pixels;       // pixels written by GLIB
+  uint32_t  transfers;    // sl_memlcd_draw calls that went through
+  uint32_t  rows;         // rows sent to the panel
+  uint32_t  bytes;        // bytes on the SPI bus, command, address and dummy bytes included
+} host_display_counters_t;
+
+extern host_display_counters_t host_display_counters;
+
+// back to power on: black panel, empty DMD pool of framebuffers entries,
+// counters cleared
+void            host_display_reset(uint32_t framebuffers);
+
+// the next count sl_memlcd_draw calls fail
+void            host_display_fail_draws(uint32_t count);
+
+// sl_memlcd_draw spins row_ns per row sent, standing in for the SPI transfer
+// time of the real panel. 0, the default, returns right away
+void            host_display_set_row_time(uint32_t row_ns);
+
+// what the panel shows, and the framebuffer GLIB draws into
+const uint8_t*  host_display_panel(void);
+uint8_t*        host_display_framebuffer(void);
+
+bool            host_display_get_pixel(const uint8_t* image, int32_t x, int32_t y);
+void            host_display_set_pixel(uint8_t* image, int32_t x, int32_t y, bool white);
+
+// number of pixels that differ between two images
+uint32_t        host_display_diff(const uint8_t* a, const uint8_t* b);
+
+// binary PBM (P4), 0 on success
+int             host_display_write_pbm(const char* path, const uint8_t* image);
+int             host_display_read_pbm(const char* path, uint8_t* image);
+
+#endif /* HOST_DISPLAY_H_ */
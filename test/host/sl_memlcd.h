@@ -0,0 +1,52 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host Stand-in for the Memory LCD Driver
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef SL_MEMLCD_H
+#define SL_MEMLCD_H
+
+#include "sl_status.h"
+
+// the fields of the memory LCD description gui_display reads, backed by
+// host_display.c
+typedef struct {
+  unsigned short  width;
+  unsigned short  height;
+  unsigned char   bpp;
+} sl_memlcd_t;
+
+const sl_memlcd_t*  sl_memlcd_get(void);
+sl_status_t         sl_memlcd_draw(const sl_memlcd_t* device, const void* data, unsigned int row_start, unsigned int row_count);
+
+#endif /* SL_MEMLCD_H */
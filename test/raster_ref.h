@@ -0,0 +1,126 @@
+/***************************************************************************//**
+ * @file
+ * @brief Per Pixel Raster Reference
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef RASTER_REF_H_
+#define RASTER_REF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "gui_display.h"
+#include "host_display.h"
+
+// what the gui_display raster calls do, one pixel at a time the way GLIB
+// draws. the kernels are checked and timed against it
+typedef enum {
+  RASTER_REF_RESTORE,
+  RASTER_REF_FILL_WHITE,
+  RASTER_REF_FILL_BLACK,
+  RASTER_REF_INVERT,
+} raster_ref_op_t;
+
+static inline void raster_ref_rect(uint8_t* image, const uint8_t* background, raster_ref_op_t op,
+                                   int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max)
+{
+  bool white;
+
+  x_min = (x_min < 0) ? 0 : x_min;
+  y_min = (y_min < 0) ? 0 : y_min;
+  x_max = (x_max > (GUI_DISPLAY_WIDTH - 1))  ? (GUI_DISPLAY_WIDTH - 1)  : x_max;
+  y_max = (y_max > (GUI_DISPLAY_HEIGHT - 1)) ? (GUI_DISPLAY_HEIGHT - 1) : y_max;
+
+  for(int32_t y = y_min; y <= y_max; y++)
+  {
+      for(int32_t x = x_min; x <= x_max; x++)
+      {
+          switch(op)
+          {
+            case RASTER_REF_RESTORE:
+              white = host_display_get_pixel(background, x, y);
+              break;
+
+            case RASTER_REF_FILL_WHITE:
+              white = true;
+              break;
+
+            case RASTER_REF_FILL_BLACK:
+              white = false;
+              break;
+
+            default:
+              white = !host_display_get_pixel(image, x, y);
+              break;
+          }
+
+          host_display_set_pixel(image, x, y, white);
+      }
+  }
+}
+
+// the same through gui_display
+static inline void raster_ref_kernel(raster_ref_op_t op, int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max)
+{
+  switch(op)
+  {
+    case RASTER_REF_RESTORE:
+      gui_display_restore_background(x_min, y_min, x_max, y_max);
+      break;
+
+    case RASTER_REF_FILL_WHITE:
+      gui_display_fill_rect(x_min, y_min, x_max, y_max, GUI_DISPLAY_WHITE);
+      break;
+
+    case RASTER_REF_FILL_BLACK:
+      gui_display_fill_rect(x_min, y_min, x_max, y_max, GUI_DISPLAY_BLACK);
+      break;
+
+    default:
+      gui_display_invert_rect(x_min, y_min, x_max, y_max);
+      break;
+  }
+}
+
+// fills an image with a pattern that differs in every bit position
+static inline void raster_ref_pattern(uint8_t* image, uint32_t seed)
+{
+  for(uint32_t i = 0; i < HOST_DISPLAY_BYTES; i++)
+  {
+      seed   = (seed * 1103515245u) + 12345u;
+      image[i] = (uint8_t) (seed >> 16);
+  }
+}
+
+#endif /* RASTER_REF_H_ */
@@ -0,0 +1,201 @@
+/***************************************************************************//**
+ * @file
+ * @brief Click Merging Simulation
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <math.h>
+#include <stdlib.h>
+
+#include "click_merge.h"
+#include "test_util.h"
+
+// Students answering with bursts of presses, merged by click_merge.c with
+// the window on and off. reports the clicks and the frames on air each
+// answer took, and the p50 / p99 latency from the last press until the base
+// station has the final answer. the main loop is taken to run right after
+// every press and window end, and each click as a confirmable POST and its
+// ACK, two frames on a link without loss
+#define SIM_ANSWERS         20000
+#define SIM_MAX_PRESSES     6
+#define SIM_CHANGE_MS       400.0     // mean time between the presses of an answer
+#define SIM_FRAMES          2         // per click
+
+typedef struct {
+  double  clicks;
+  double  p50_ms;
+  double  p99_ms;
+  double  max_ms;
+} sim_result_t;
+
+static const uint32_t windows_ms[] = { 0, 100, 200, 500 };
+
+static uint64_t sim_state;
+
+// xorshift64*, the same sequence on every host
+static double sim_uniform(void)
+{
+  sim_state ^= sim_state >> 12;
+  sim_state ^= sim_state << 25;
+  sim_state ^= sim_state >> 27;
+
+  return (double) ((sim_state * 2685821657736338717ull) >> 11) / (double) (1ull << 53);
+}
+
+static int sim_compare(const void* a, const void* b)
+{
+  double x = *(const double*) a;
+  double y = *(const double*) b;
+
+  return (x > y) - (x < y);
+}
+
+static sim_result_t sim_run(uint32_t window_ms)
+{
+  static double latency[SIM_ANSWERS];
+  click_merge_t merge;
+  sim_result_t  result  = { 0 };
+  uint32_t      clicks  = 0;
+
+  sim_state = 0x9e3779b97f4a7c15ull;
+
+  for(uint32_t i = 0; i < SIM_ANSWERS; i++)
+  {
+      double    press_at[SIM_MAX_PRESSES];
+      char      press_answer[SIM_MAX_PRESSES];
+      uint32_t  presses       = 1;
+      uint32_t  next          = 0;
+      uint32_t  sent          = 0;
+      double    timer_at      = INFINITY;
+      double    now;
+      char      delivered     = 0;
+      double    delivered_at  = 0.0;
+      char      answer;
+
+      // a burst of presses, each one likely a change of mind
+      press_at[0]     = 0.0;
+      press_answer[0] = (sim_uniform() < 0.5) ? 'A' : 'B';
+
+      while((presses < SIM_MAX_PRESSES) && (sim_uniform() < 0.5))
+      {
+          press_at[presses]     = press_at[presses - 1] - (SIM_CHANGE_MS * log(1.0 - sim_uniform()));
+          press_answer[presses] = (sim_uniform() < 0.7) ? ((press_answer[presses - 1] == 'A') ? 'B' : 'A')
+                                                        : press_answer[presses - 1];
+          presses++;
+      }
+
+      // every answer starts with the window closed
+      click_merge_init(&merge, window_ms);
+
+      while((next < presses) || (timer_at != INFINITY))
+      {
+          if((next < presses) && (press_at[next] < timer_at))
+          {
+              now = press_at[next];
+              if(click_merge_press(&merge, press_answer[next]))
+              {
+                  timer_at = now + window_ms;
+              }
+              next++;
+          }
+          else
+          {
+              now       = timer_at;
+              timer_at  = click_merge_window_end(&merge) ? (now + window_ms) : INFINITY;
+          }
+
+          answer = click_merge_take(&merge);
+          if(answer != 0)
+          {
+              sent++;
+
+              if(answer != delivered)
+              {
+                  delivered     = answer;
+                  delivered_at  = now;
+              }
+          }
+      }
+
+      // the base station ends up with the last press
+      CHECK_EQ(delivered, press_answer[presses - 1]);
+
+      // nothing merged without a window
+      if(window_ms == 0)
+      {
+          CHECK_EQ(sent, presses);
+      }
+
+      latency[i]  = fmax(0.0, delivered_at - press_at[presses - 1]);
+      clicks     += sent;
+  }
+
+  qsort(latency, SIM_ANSWERS, sizeof(latency[0]), sim_compare);
+
+  result.clicks = (double) clicks / SIM_ANSWERS;
+  result.p50_ms = latency[SIM_ANSWERS / 2];
+  result.p99_ms = latency[(SIM_ANSWERS * 99) / 100];
+  result.max_ms = latency[SIM_ANSWERS - 1];
+
+  return result;
+}
+
+int main(void)
+{
+  sim_result_t result;
+  sim_result_t off = { 0 };
+
+  printf("%-10s %10s %10s %8s %8s\n", "window ms", "clicks", "frames", "p50 ms", "p99 ms");
+
+  for(uint32_t i = 0; i < sizeof(windows_ms) / sizeof(windows_ms[0]); i++)
+  {
+      result = sim_run(windows_ms[i]);
+
+      printf("%-10u %10.2f %10.2f %8.0f %8.0f\n", windows_ms[i], result.clicks,
+             SIM_FRAMES * result.clicks, result.p50_ms, result.p99_ms);
+
+      if(windows_ms[i] == 0)
+      {
+          off = result;
+          CHECK_EQ(result.max_ms, 0);
+      }
+      else
+      {
+          // never more clicks than presses, the final answer is at most one
+          // window late
+          CHECK(result.clicks <= off.clicks);
+          CHECK(result.max_ms <= windows_ms[i]);
+      }
+  }
+
+  return TEST_RESULT();
+}
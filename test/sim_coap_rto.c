@@ -0,0 +1,250 @@
+/***************************************************************************//**
+ * @file
+ * @brief CoAP Retransmission Timeout Simulation
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <math.h>
+#include <stdlib.h>
+
+#include "coap_rto.h"
+#include "test_util.h"
+
+// Confirmable clicks over a lossy link with random delay, the ACK timeout
+// once from coap_rto.c and once fixed at the OpenThread default. reports
+// the p50 / p99 latency from the press until the base station has the
+// click, and the transmissions each click took.
+//
+// the retransmissions follow RFC 7252 as OpenThread does them, the first
+// wait is the ACK timeout stretched by a random factor of up to 1.5 and
+// each later one doubles. the base station acks every copy it gets. clicks
+// are played one after the other, each sees the estimate left by all the
+// clicks before it
+#define SIM_CLICKS          20000
+#define SIM_GAP_MS          3000.0      // mean time between presses
+#define SIM_RTO_INITIAL_MS  2000        // COAP_CLIENT_RTO_INITIAL_MS
+#define SIM_RTO_MIN_MS      1000        // OT_COAP_MIN_ACK_TIMEOUT
+#define SIM_RTO_MAX_MS      32000       // COAP_CLIENT_RTO_MAX_MS
+#define SIM_LOST            INFINITY
+
+// what the adaptive RTO has to do better than the fixed one on a link
+typedef enum {
+  SIM_EXPECT_FASTER,          // lower p99, short RTTs retry sooner
+  SIM_EXPECT_FEWER_TX,        // fewer transmissions, RTTs beyond the default back off
+} sim_expect_t;
+
+typedef struct {
+  const char*   name;
+  double        loss;         // per transmission, either direction
+  double        delay_ms;     // fixed part of the one way delay
+  double        jitter_ms;    // mean of the exponential part
+  sim_expect_t  expect;
+} sim_link_t;
+
+typedef struct {
+  double      p50_ms;
+  double      p99_ms;
+  double      delivered;      // share of the clicks that reached the base station
+  double      tx_per_click;
+} sim_result_t;
+
+static const sim_link_t links[] = {
+    { "quiet",      0.02,  10.0,   5.0, SIM_EXPECT_FASTER },
+    { "lossy",      0.20,  20.0,  10.0, SIM_EXPECT_FASTER },
+    { "deep",       0.10,  60.0,  40.0, SIM_EXPECT_FASTER },
+    { "congested",  0.15, 900.0, 600.0, SIM_EXPECT_FEWER_TX },
+};
+
+static uint64_t sim_state;
+
+// xorshift64*, the same sequence on every host
+static double sim_uniform(void)
+{
+  sim_state ^= sim_state >> 12;
+  sim_state ^= sim_state << 25;
+  sim_state ^= sim_state >> 27;
+
+  return (double) ((sim_state * 2685821657736338717ull) >> 11) / (double) (1ull << 53);
+}
+
+// one way trip, SIM_LOST when the frame doesn't make it
+static double sim_trip(const sim_link_t* link)
+{
+  if(sim_uniform() < link->loss)
+  {
+      return SIM_LOST;
+  }
+
+  return link->delay_ms - (link->jitter_ms * log(1.0 - sim_uniform()));
+}
+
+static int sim_compare(const void* a, const void* b)
+{
+  double x = *(const double*) a;
+  double y = *(const double*) b;
+
+  return (x > y) - (x < y);
+}
+
+static sim_result_t sim_run(const sim_link_t* link, bool adaptive)
+{
+  static double latency[SIM_CLICKS];
+  coap_rto_t    rto;
+  sim_result_t  result      = { 0 };
+  double        now         = 0.0;
+  double        updated     = 0.0;
+  double        arrival;
+  double        response;
+  double        sent;
+  double        wait;
+  uint32_t      ack_timeout;
+  uint32_t      delivered   = 0;
+  uint32_t      tx          = 0;
+
+  sim_state = 0x9e3779b97f4a7c15ull;
+  coap_rto_init(&rto, SIM_RTO_INITIAL_MS, SIM_RTO_MIN_MS, SIM_RTO_MAX_MS);
+
+  for(uint32_t click = 0; click < SIM_CLICKS; click++)
+  {
+      now -= SIM_GAP_MS * log(1.0 - sim_uniform());
+
+      if(adaptive && coap_rto_age(&rto, (uint32_t) (now - updated)))
+      {
+          updated = now;
+      }
+
+      ack_timeout = adaptive ? coap_rto_ack_timeout(&rto) : SIM_RTO_INITIAL_MS;
+      wait        = ack_timeout * (1.0 + (sim_uniform() * (COAP_RTO_RANDOM_FACTOR_NUM - COAP_RTO_RANDOM_FACTOR_DEN) / COAP_RTO_RANDOM_FACTOR_DEN));
+      sent        = now;
+      arrival     = SIM_LOST;
+      response    = SIM_LOST;
+
+      // transmissions until the first response is back or the retries run out
+      for(uint32_t attempt = 0; attempt <= COAP_RTO_MAX_RETRANSMIT; attempt++)
+      {
+          double trip = sim_trip(link);
+
+          tx++;
+
+          if(trip != SIM_LOST)
+          {
+              double back = sim_trip(link);
+
+              arrival = fmin(arrival, sent + trip);
+
+              if(back != SIM_LOST)
+              {
+                  response = fmin(response, sent + trip + back);
+              }
+          }
+
+          sent += wait;
+          wait *= 2.0;
+
+          if(response <= sent)
+          {
+              break;
+          }
+      }
+
+      latency[click] = (arrival == SIM_LOST) ? SIM_LOST : (arrival - now);
+      delivered     += (arrival != SIM_LOST);
+
+      // OpenThread gives up after the last wait, a later response is ignored
+      if(adaptive && (response < sent) &&
+         (coap_rto_update(&rto, (uint32_t) (response - now), ack_timeout) != COAP_RTO_SAMPLE_DROPPED))
+      {
+          updated = response;
+      }
+  }
+
+  qsort(latency, SIM_CLICKS, sizeof(latency[0]), sim_compare);
+
+  result.p50_ms       = latency[SIM_CLICKS / 2];
+  result.p99_ms       = latency[(SIM_CLICKS * 99) / 100];
+  result.delivered    = (double) delivered / SIM_CLICKS;
+  result.tx_per_click = (double) tx / SIM_CLICKS;
+
+  return result;
+}
+
+// the retransmission count inferred from the RTT, see coap_rto_update
+static void sim_check_classes(void)
+{
+  coap_rto_t rto;
+
+  coap_rto_init(&rto, SIM_RTO_INITIAL_MS, SIM_RTO_MIN_MS, SIM_RTO_MAX_MS);
+
+  CHECK_EQ(coap_rto_update(&rto, 999, 1000), COAP_RTO_SAMPLE_STRONG);
+  CHECK_EQ(coap_rto_update(&rto, 1000, 1000), COAP_RTO_SAMPLE_WEAK);
+  CHECK_EQ(coap_rto_update(&rto, 6999, 1000), COAP_RTO_SAMPLE_WEAK);
+  CHECK_EQ(coap_rto_update(&rto, 7000, 1000), COAP_RTO_SAMPLE_DROPPED);
+  CHECK(rto.strong.valid && rto.weak.valid);
+
+  coap_rto_reset(&rto);
+  CHECK_EQ(coap_rto_ack_timeout(&rto), SIM_RTO_INITIAL_MS);
+}
+
+int main(void)
+{
+  sim_result_t fixed;
+  sim_result_t adaptive;
+
+  sim_check_classes();
+
+  printf("%-10s %-8s %9s %9s %10s %9s\n", "link", "rto", "p50 ms", "p99 ms", "delivered", "tx/click");
+
+  for(uint32_t i = 0; i < sizeof(links) / sizeof(links[0]); i++)
+  {
+      fixed     = sim_run(&links[i], false);
+      adaptive  = sim_run(&links[i], true);
+
+      printf("%-10s %-8s %9.0f %9.0f %9.2f%% %9.2f\n", links[i].name, "fixed",
+             fixed.p50_ms, fixed.p99_ms, 100.0 * fixed.delivered, fixed.tx_per_click);
+      printf("%-10s %-8s %9.0f %9.0f %9.2f%% %9.2f\n", links[i].name, "adaptive",
+             adaptive.p50_ms, adaptive.p99_ms, 100.0 * adaptive.delivered, adaptive.tx_per_click);
+
+      CHECK(adaptive.delivered >= fixed.delivered);
+
+      if(links[i].expect == SIM_EXPECT_FASTER)
+      {
+          CHECK(adaptive.p99_ms < fixed.p99_ms);
+          CHECK(adaptive.tx_per_click <= (fixed.tx_per_click * 1.05));
+      }
+      else
+      {
+          CHECK(adaptive.tx_per_click < fixed.tx_per_click);
+      }
+  }
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,132 @@
+/***************************************************************************//**
+ * @file
+ * @brief Base Station Selection Tests
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include "base_station_select.h"
+#include "test_util.h"
+
+#define OWN_RLOC16    0x0801    // child 1 of router 2
+
+typedef struct {
+  uint16_t  rloc16;
+  uint8_t   cost;
+} server_t;
+
+// offer servers in order, the pick or BASE_STATION_RLOC16_INVALID
+static uint16_t pick(const server_t* servers, uint32_t count, uint16_t failed_rloc16)
+{
+  base_station_select_t select;
+  uint16_t              rloc16 = BASE_STATION_RLOC16_INVALID;
+
+  base_station_select_init(&select, failed_rloc16);
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+      base_station_select_offer(&select, servers[i].rloc16, servers[i].cost);
+  }
+
+  if(!base_station_select_result(&select, &rloc16))
+  {
+      return BASE_STATION_RLOC16_INVALID;
+  }
+
+  return rloc16;
+}
+
+static void test_path_cost(void)
+{
+  CHECK_EQ(base_station_path_cost(OWN_RLOC16, OWN_RLOC16, BASE_STATION_PATH_COST_UNKNOWN), 0);
+  CHECK_EQ(base_station_path_cost(OWN_RLOC16, 0x1000, 3), 3);
+  CHECK_EQ(base_station_path_cost(OWN_RLOC16, 0x1001, 3), 4);
+  CHECK_EQ(base_station_path_cost(OWN_RLOC16, 0x1000, BASE_STATION_PATH_COST_UNKNOWN), BASE_STATION_PATH_COST_UNKNOWN);
+  CHECK_EQ(base_station_path_cost(OWN_RLOC16, 0x1001, 0xff), BASE_STATION_PATH_COST_UNKNOWN);
+}
+
+static void test_lowest_cost(void)
+{
+  const server_t servers[] = {
+      { 0x0400, 4 },
+      { 0x1000, 1 },
+      { 0x2c01, 2 },
+      { 0x3000, BASE_STATION_PATH_COST_UNKNOWN },
+  };
+
+  CHECK_EQ(pick(servers, 4, BASE_STATION_RLOC16_INVALID), 0x1000);
+
+  // ties go to the first one offered
+  CHECK_EQ(pick((const server_t[]) { { 0x0400, 2 }, { 0x2c01, 2 } }, 2, BASE_STATION_RLOC16_INVALID), 0x0400);
+
+  // one without a route still beats none
+  CHECK_EQ(pick(&servers[3], 1, BASE_STATION_RLOC16_INVALID), 0x3000);
+
+  CHECK_EQ(pick(servers, 0, BASE_STATION_RLOC16_INVALID), BASE_STATION_RLOC16_INVALID);
+}
+
+// the server that timed out is passed over even when it is the closest, and
+// ranks behind one the router table has no route to
+static void test_failover(void)
+{
+  const server_t servers[] = {
+      { 0x1000, 1 },
+      { 0x0400, 4 },
+      { 0x3000, BASE_STATION_PATH_COST_UNKNOWN },
+  };
+
+  CHECK_EQ(pick(servers, 3, 0x1000), 0x0400);
+  CHECK_EQ(pick(servers, 3, 0x0400), 0x1000);
+
+  CHECK_EQ(pick((const server_t[]) { { 0x1000, 1 }, { 0x3000, BASE_STATION_PATH_COST_UNKNOWN } }, 2, 0x1000),
+           0x3000);
+}
+
+// with only the failed one registered it is used again
+static void test_fallback(void)
+{
+  const server_t servers[] = {
+      { 0x1000, 1 },
+  };
+
+  CHECK_EQ(pick(servers, 1, 0x1000), 0x1000);
+  CHECK_EQ(pick((const server_t[]) { { 0x1000, BASE_STATION_PATH_COST_UNKNOWN } }, 1, 0x1000), 0x1000);
+}
+
+int main(void)
+{
+  test_path_cost();
+  test_lowest_cost();
+  test_failover();
+  test_fallback();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,266 @@
+/***************************************************************************//**
+ * @file
+ * @brief Click Deduplication Tests
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "click_dedup.h"
+#include "test_util.h"
+
+#define WINDOWS           4
+#define STREAM_CLICKS     5000u
+#define STREAM_COPIES     3       // transmissions of each click, any may be lost
+#define STREAM_REORDER    24      // max seqs a copy lands late, within the bitmap
+
+static click_window_t windows[WINDOWS];
+static click_dedup_t  dedup;
+
+static const uint8_t  eui_a[8] = { 0x00, 0x0b, 0x57, 0xff, 0xfe, 0x00, 0x00, 0x0a };
+static const uint8_t  eui_b[8] = { 0x00, 0x0b, 0x57, 0xff, 0xfe, 0x00, 0x00, 0x0b };
+
+static bool accept(const uint8_t* eui64, uint16_t epoch, uint16_t seq)
+{
+  click_window_t* window = click_dedup_lookup(&dedup, eui64, epoch);
+
+  return (window != NULL) && click_dedup_accept(&dedup, window, seq);
+}
+
+// each seq counted once, in any order within the bitmap
+static void test_window(void)
+{
+  click_window_t* window;
+
+  click_dedup_init(&dedup, windows, WINDOWS);
+
+  CHECK(accept(eui_a, 1, 1));
+  CHECK(!accept(eui_a, 1, 1));
+  CHECK(accept(eui_a, 1, 3));
+  CHECK(accept(eui_a, 1, 2));
+  CHECK(!accept(eui_a, 1, 3));
+  CHECK(!accept(eui_a, 1, 2));
+
+  window = click_dedup_lookup(&dedup, eui_a, 1);
+  CHECK_EQ(window->last, 3);
+  CHECK_EQ(window->seen, 0);
+
+  // 5 lost, 6 and 8 held in the bitmap
+  CHECK(accept(eui_a, 1, 4));
+  CHECK(accept(eui_a, 1, 6));
+  CHECK(accept(eui_a, 1, 8));
+  CHECK_EQ(window->last, 4);
+  CHECK_EQ(window->seen, 0x0a);
+  CHECK(!accept(eui_a, 1, 8));
+
+  // far beyond the bitmap, the oldest gaps are given up
+  CHECK(accept(eui_a, 1, 100));
+  CHECK_EQ(window->last, 68);
+  CHECK(!accept(eui_a, 1, 5));
+  CHECK(accept(eui_a, 1, 99));
+}
+
+// a rebooted remote numbers from 1 again under a new epoch, late copies of
+// the old run still hit the old window
+static void test_epoch(void)
+{
+  click_dedup_init(&dedup, windows, WINDOWS);
+
+  for(uint16_t seq = 1; seq <= 40; seq++)
+  {
+      CHECK(accept(eui_a, 0x1234, seq));
+  }
+
+  CHECK(accept(eui_a, 0x9876, 1));
+  CHECK(accept(eui_a, 0x9876, 2));
+  CHECK(!accept(eui_a, 0x1234, 1));
+  CHECK(!accept(eui_a, 0x1234, 40));
+  CHECK(!accept(eui_a, 0x9876, 1));
+  CHECK(accept(eui_a, 0x1234, 41));
+}
+
+// a base station that starts while a remote is far into its run counts the
+// first click it gets, even past the half of the seq space, and the clicks
+// before it that are still on their way
+static void test_late_join(void)
+{
+  click_dedup_init(&dedup, windows, WINDOWS);
+
+  CHECK(accept(eui_a, 7, 500));
+  CHECK(!accept(eui_a, 7, 500));
+  CHECK(accept(eui_a, 7, 501));
+  CHECK(accept(eui_a, 7, 499));
+  CHECK(accept(eui_a, 7, 470));
+  CHECK(!accept(eui_a, 7, 499));
+
+  CHECK(accept(eui_b, 7, 40000));
+  CHECK(accept(eui_b, 7, 40001));
+  CHECK(!accept(eui_b, 7, 40000));
+  CHECK(accept(eui_b, 7, 39999));
+
+  // seqs wrap after 65535
+  CHECK(accept(eui_b, 8, 65535));
+  CHECK(accept(eui_b, 8, 0));
+  CHECK(accept(eui_b, 8, 1));
+  CHECK(!accept(eui_b, 8, 65535));
+}
+
+// 40 lost or overtaken by 41 on the way to a base station that never saw
+// the remote before, both count and the ack doesn't claim 40 early
+static void test_late_join_reorder(void)
+{
+  click_window_t* window;
+
+  click_dedup_init(&dedup, windows, WINDOWS);
+
+  CHECK(accept(eui_a, 3, 41));
+  window = click_dedup_lookup(&dedup, eui_a, 3);
+  CHECK((uint16_t) (40 - window->last) <= 32);
+  CHECK_EQ(window->seen & (1u << (40 - window->last - 1)), 0);
+
+  CHECK(accept(eui_a, 3, 40));
+  CHECK(!accept(eui_a, 3, 40));
+  CHECK(!accept(eui_a, 3, 41));
+}
+
+// a full table refuses unknown remotes and keeps counting the known ones, a
+// known remote that rebooted takes over its own least recent window
+static void test_full(void)
+{
+  uint8_t         eui[8];
+  click_window_t* window;
+
+  click_dedup_init(&dedup, windows, WINDOWS);
+
+  for(uint8_t i = 0; i < WINDOWS - 1; i++)
+  {
+      memcpy(eui, eui_b, sizeof(eui));
+      eui[7] = (uint8_t) (0x10 + i);
+      CHECK(accept(eui, 1, 1));
+  }
+
+  CHECK(accept(eui_a, 1, 1));
+  CHECK(accept(eui_a, 1, 2));
+
+  CHECK(click_dedup_lookup(&dedup, eui_b, 1) == NULL);
+  CHECK(!accept(eui_b, 1, 1));
+
+  for(uint8_t i = 0; i < WINDOWS - 1; i++)
+  {
+      memcpy(eui, eui_b, sizeof(eui));
+      eui[7] = (uint8_t) (0x10 + i);
+      CHECK(!accept(eui, 1, 1));
+      CHECK(accept(eui, 1, 2));
+  }
+
+  // reboot with every window taken, epoch 1 is replaced
+  CHECK(accept(eui_a, 2, 1));
+  window = click_dedup_lookup(&dedup, eui_a, 2);
+  CHECK_EQ(window->epoch, 2);
+  CHECK_EQ(window->last, 1);
+
+  for(uint32_t i = 0; i < WINDOWS; i++)
+  {
+      CHECK(!windows[i].in_use || (memcmp(windows[i].eui64, eui_a, sizeof(eui_a)) != 0) ||
+            (windows[i].epoch == 2));
+  }
+}
+
+typedef struct {
+  uint32_t  time;
+  uint16_t  seq;
+} arrival_t;
+
+static int arrival_compare(const void* a, const void* b)
+{
+  const arrival_t* x = a;
+  const arrival_t* y = b;
+
+  return (x->time > y->time) - (x->time < y->time);
+}
+
+// every click sent STREAM_COPIES times with random loss and a random delay
+// of less than STREAM_REORDER clicks, each click that got through at least
+// once is counted exactly once
+static void test_stream(void)
+{
+  static arrival_t  arrivals[STREAM_CLICKS * STREAM_COPIES];
+  static uint8_t    delivered[STREAM_CLICKS + 1];
+  uint32_t          count     = 0;
+  uint32_t          expected  = 0;
+  uint32_t          counted   = 0;
+
+  click_dedup_init(&dedup, windows, WINDOWS);
+  srand(1);
+
+  for(uint16_t seq = 1; seq <= STREAM_CLICKS; seq++)
+  {
+      for(uint32_t copy = 0; copy < STREAM_COPIES; copy++)
+      {
+          if((rand() % 4) != 0)
+          {
+              arrivals[count].time  = (seq * STREAM_COPIES) + copy + (uint32_t) (rand() % (STREAM_REORDER * STREAM_COPIES));
+              arrivals[count].seq   = seq;
+              count++;
+              delivered[seq]        = 1;
+          }
+      }
+
+      expected += delivered[seq];
+  }
+
+  qsort(arrivals, count, sizeof(arrivals[0]), arrival_compare);
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+      if(accept(eui_a, 42, arrivals[i].seq))
+      {
+          counted++;
+      }
+  }
+
+  CHECK(expected < STREAM_CLICKS);
+  CHECK_EQ(counted, expected);
+}
+
+int main(void)
+{
+  test_window();
+  test_epoch();
+  test_late_join();
+  test_late_join_reorder();
+  test_full();
+  test_stream();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,658 @@
+/***************************************************************************//**
+ * @file
+ * @brief GUI Golden Image Tests
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "gui.h"
+#include "gui_display.h"
+#include "gui_event_queue.h"
+#include "remote_port.h"
+#include "host_display.h"
+#include "test_util.h"
+
+// Every GUI_EVENT_FLAG_* path is rendered on the in-memory display and what
+// reached the panel is compared with an image in test/golden. Set
+// UPDATE_GOLDEN=1 to rewrite the images after an intended change, a mismatch
+// leaves the rendered image next to the test binary as <name>.actual.pbm.
+
+static bool gui_idle(void)
+{
+  gui_event_queue_stats_t stats;
+  uint32_t                depth = 0;
+
+  for(gui_event_lane_t lane = 0; lane < GUI_EVENT_LANE_COUNT; lane++)
+  {
+      gui_event_queue_get_stats(lane, &stats);
+      depth += stats.depth;
+  }
+
+  return (depth == 0) && !gui_display_is_busy() && !gui_display_is_dirty();
+}
+
+// run the main loop side until everything queued is on the panel
+static void gui_settle(void)
+{
+  for(uint32_t pass = 0; (pass < 1000) && !gui_idle(); pass++)
+  {
+      gui_frame_tick();
+      gui_update();
+  }
+
+  CHECK(gui_idle());
+  CHECK(!gui_is_busy());
+
+  // nothing drawn is left out of a flush
+  CHECK_EQ(memcmp(host_display_panel(), gui_display_get_framebuffer(), HOST_DISPLAY_BYTES), 0);
+}
+
+static uint32_t stats_glyph_pixels(void)
+{
+  gui_display_stats_t stats;
+
+  CHECK_EQ(gui_display_get_stats(&stats), SL_STATUS_OK);
+
+  return stats.glyph_pixels;
+}
+
+static void check_golden(const char* name)
+{
+  char      path[512];
+  uint8_t   golden[HOST_DISPLAY_BYTES];
+  uint32_t  differ;
+
+  printf("%-18s glyph pixels %6u  transfers %3u  rows %4u  bytes %5u\n", name,
+         stats_glyph_pixels(), host_display_counters.transfers,
+         host_display_counters.rows, host_display_counters.bytes);
+
+  snprintf(path, sizeof(path), "%s/%s.pbm", GOLDEN_DIR, name);
+
+  if(getenv("UPDATE_GOLDEN") != NULL)
+  {
+      CHECK_EQ(host_display_write_pbm(path, host_display_panel()), 0);
+      return;
+  }
+
+  if(host_display_read_pbm(path, golden) != 0)
+  {
+      fprintf(stderr, "%s: missing golden image\n", path);
+      test_failures++;
+      return;
+  }
+
+  differ = host_display_diff(host_display_panel(), golden);
+  CHECK_EQ(differ, 0);
+
+  if(differ != 0)
+  {
+      snprintf(path, sizeof(path), "%s.actual.pbm", name);
+      host_display_write_pbm(path, host_display_panel());
+  }
+}
+
+static void queue_event(const gui_event_t* event)
+{
+  CHECK_EQ(gui_event_queue_add(event), SL_STATUS_OK);
+}
+
+static void queue_log(gui_log_id_t id, uint16_t arg, const char* text)
+{
+  gui_event_t event = {
+      .flag     = GUI_EVENT_FLAG_LOG,
+      .log.id   = id,
+      .log.arg  = arg,
+      .log.text = text,
+  };
+
+  queue_event(&event);
+}
+
+static uint32_t stats_glyphs(void)
+{
+  gui_display_stats_t stats;
+
+  CHECK_EQ(gui_display_get_stats(&stats), SL_STATUS_OK);
+
+  return stats.glyphs;
+}
+
+static void test_boot(void)
+{
+  host_display_reset(HOST_DISPLAY_FRAMEBUFFERS);
+
+  CHECK_EQ(gui_init(), SL_STATUS_OK);
+  gui_settle();
+
+  check_golden("boot");
+}
+
+static void test_network_state(void)
+{
+  gui_event_t             event;
+  gui_event_queue_stats_t stats;
+  uint32_t                coalesced, glyphs;
+
+  event.flag = GUI_EVENT_FLAG_NTWK_ADDR;
+  memcpy(event.eui64, (const uint8_t[]) {0x00, 0x0b, 0x57, 0xff, 0xfe, 0x64, 0x8d, 0x1a}, 8);
+  queue_event(&event);
+  gui_settle();
+  check_golden("ntwk_addr");
+
+  event.flag = GUI_EVENT_FLAG_NTWK_NAME;
+  event.text = "OpenThread-1c2d";
+  queue_event(&event);
+  gui_settle();
+  check_golden("ntwk_name");
+
+  event.flag    = GUI_EVENT_FLAG_NTWK_CH;
+  event.channel = 15;
+  queue_event(&event);
+  gui_settle();
+  check_golden("ntwk_ch");
+
+  event.flag = GUI_EVENT_FLAG_NTWK_ROLE;
+  event.text = "child";
+  queue_event(&event);
+  gui_settle();
+  check_golden("ntwk_role");
+
+  // a shorter value clears the rest of the old one. "router" is superseded
+  // before it is rendered
+  gui_event_queue_get_stats(GUI_EVENT_LANE_STATE, &stats);
+  coalesced = stats.coalesced;
+
+  event.flag = GUI_EVENT_FLAG_NTWK_ROLE;
+  event.text = "router";
+  queue_event(&event);
+  event.text = "leader";
+  queue_event(&event);
+  event.flag = GUI_EVENT_FLAG_NTWK_NAME;
+  event.text = "oc";
+  queue_event(&event);
+
+  gui_event_queue_get_stats(GUI_EVENT_LANE_STATE, &stats);
+  CHECK_EQ(stats.coalesced - coalesced, 1);
+  CHECK_EQ(stats.depth, 2);
+
+  // "child" to "leader" is 6 glyphs, "OpenThread-1c" to "oc" 2. rendering
+  // "router" on the way would have added the 4 of "rout" to "lead"
+  glyphs = stats_glyphs();
+  gui_settle();
+  CHECK_EQ(stats_glyphs() - glyphs, 6 + 2);
+  check_golden("ntwk_update");
+}
+
+static void test_log(void)
+{
+  queue_log(GUI_LOG_HELLO, 0, NULL);
+  gui_settle();
+  check_golden("log_one");
+
+  // more lines than the window holds, the oldest scroll out
+  queue_log(GUI_LOG_READY_TO_JOIN, 0, NULL);
+  queue_log(GUI_LOG_JOINER_SEARCHING, 0, NULL);
+  queue_log(GUI_LOG_JOINER_ERROR, 0, "NotFound");
+  queue_log(GUI_LOG_JOINER_JOINED, 0, NULL);
+  queue_log(GUI_LOG_COAP_TX, 'A', NULL);
+
+  // LOG_EVENTS_PER_UPDATE lines a pass, the device stays awake for the rest
+  CHECK(gui_is_busy());
+  gui_update();
+  CHECK(gui_is_busy());
+
+  gui_settle();
+  check_golden("log_scroll");
+}
+
+static void test_buttons(void)
+{
+  static const struct {
+    uint8_t     button;
+    const char* pressed;
+  } buttons[] = {
+      { 0, "btn0_pressed" },
+      { 1, "btn1_pressed" },
+  };
+
+  uint8_t released[HOST_DISPLAY_BYTES];
+
+  memcpy(released, host_display_panel(), sizeof(released));
+
+  for(uint32_t i = 0; i < 2; i++)
+  {
+      gui_button_handler(buttons[i].button, true);
+      gui_settle();
+      check_golden(buttons[i].pressed);
+
+      // releasing puts back exactly what was there
+      gui_button_handler(buttons[i].button, false);
+      gui_settle();
+      CHECK_EQ(host_display_diff(host_display_panel(), released), 0);
+  }
+}
+
+// button feedback while the log lane is full and a log redraw is on its way
+// to the panel. the press must be on the panel after the first pass, a single
+// FIFO would have held it behind every queued line
+static void test_button_under_log_flood(void)
+{
+  const uint32_t          button_rows = 112 * HOST_DISPLAY_ROW_BYTES;
+  char                    path[512];
+  uint8_t                 golden[HOST_DISPLAY_BYTES];
+  gui_event_queue_stats_t stats;
+  uint32_t                passes = 0;
+  uint32_t                rows;
+  uint64_t                start, elapsed;
+
+  snprintf(path, sizeof(path), "%s/btn1_pressed.pbm", GOLDEN_DIR);
+  CHECK_EQ(host_display_read_pbm(path, golden), 0);
+
+  // scroll the log window and let the flush get going
+  for(uint32_t i = 0; i < 4; i++)
+  {
+      queue_log(GUI_LOG_JOINER_SEARCHING, 0, NULL);
+  }
+  gui_frame_tick();
+  gui_update();
+  CHECK(gui_display_is_busy());
+
+  // fill the log lane up
+  for(uint32_t i = 0; i < 32; i++)
+  {
+      queue_log((i & 1) ? GUI_LOG_JOINER_SEARCHING : GUI_LOG_JOINER_ERROR, 0, "NotFound");
+  }
+
+  gui_event_queue_get_stats(GUI_EVENT_LANE_LOG, &stats);
+  CHECK(stats.depth > 0);
+
+  rows  = host_display_counters.rows;
+  start = test_now_ns();
+
+  gui_button_handler(1, true);
+
+  // no frame tick, button feedback must not wait for one
+  while((passes < 100) &&
+        (memcmp(&host_display_panel()[button_rows], &golden[button_rows], HOST_DISPLAY_BYTES - button_rows) != 0))
+  {
+      gui_update();
+      passes++;
+  }
+
+  elapsed = test_now_ns() - start;
+  rows    = host_display_counters.rows - rows;
+
+  printf("button under flood passes %u  rows %u  %llu ns, %u log lines queued\n",
+         passes, rows, (unsigned long long) elapsed, stats.depth);
+
+  CHECK_EQ(passes, 1);
+  CHECK(rows <= GUI_DISPLAY_ROWS_PER_PROCESS);
+
+  gui_settle();
+
+  gui_button_handler(1, false);
+  gui_settle();
+}
+
+// the role line, "state: " then the role, see gui_print_device_role and the
+// text field placement in gui_init
+#define ROLE_X        2
+#define ROLE_Y        34
+#define ROLE_CELL_W   6
+#define ROLE_CELL_H   8
+#define ROLE_TEXT_LEN 19
+
+static void set_role(const char* role)
+{
+  gui_event_t event = { .flag = GUI_EVENT_FLAG_NTWK_ROLE, .text = role };
+
+  queue_event(&event);
+}
+
+// pixels that differ between a and b, counted as in or out of glyph cells
+// first..last of the role line
+static void diff_cells(const uint8_t* a, const uint8_t* b, uint32_t first, uint32_t last,
+                       uint32_t* inside, uint32_t* outside)
+{
+  bool in;
+
+  *inside   = 0;
+  *outside  = 0;
+
+  for(int32_t y = 0; y < HOST_DISPLAY_HEIGHT; y++)
+  {
+      for(int32_t x = 0; x < HOST_DISPLAY_WIDTH; x++)
+      {
+          if(host_display_get_pixel(a, x, y) == host_display_get_pixel(b, x, y))
+          {
+              continue;
+          }
+
+          in = (y >= ROLE_Y) && (y < (ROLE_Y + ROLE_CELL_H)) &&
+               (x >= (int32_t) (ROLE_X + (first * ROLE_CELL_W))) &&
+               (x < (int32_t) (ROLE_X + ((last + 1) * ROLE_CELL_W)));
+
+          *inside  += in;
+          *outside += !in;
+      }
+  }
+}
+
+// black pixels of after in the glyph cells first..last of the role line that
+// differ from before, the pixels the glyph blits of an update write
+static uint32_t black_changed_cells(const uint8_t* before, const uint8_t* after, uint32_t first, uint32_t last)
+{
+  uint32_t  black = 0;
+  uint32_t  cell_black;
+  bool      changed;
+  int32_t   x_min;
+
+  for(uint32_t i = first; i <= last; i++)
+  {
+      x_min       = ROLE_X + (i * ROLE_CELL_W);
+      cell_black  = 0;
+      changed     = false;
+
+      for(int32_t y = ROLE_Y; y < (ROLE_Y + ROLE_CELL_H); y++)
+      {
+          for(int32_t x = x_min; x < (x_min + ROLE_CELL_W); x++)
+          {
+              cell_black += !host_display_get_pixel(after, x, y);
+              changed     = changed || (host_display_get_pixel(before, x, y) != host_display_get_pixel(after, x, y));
+          }
+      }
+
+      black += changed ? cell_black : 0;
+  }
+
+  return black;
+}
+
+// a text field update only touches the glyph cells that changed and only
+// flushes the field rows, and ends up the same as drawing the text at once
+static void test_text_field_diff(void)
+{
+  static const struct {
+    const char* role;
+    uint32_t    first;      // changed cells
+    uint32_t    last;
+  } steps[] = {
+      { "chile",  11, 11 },   // from "child", one glyph
+      { "router",  7, 12 },   // every glyph of the role but the 'e'
+      { "leader",  7, 10 },   // "rout" -> "lead", "er" stays
+  };
+
+  uint8_t   before[HOST_DISPLAY_BYTES];
+  uint8_t   after[HOST_DISPLAY_BYTES];
+  uint32_t  pixels, rows, inside, outside;
+
+  set_role("child");
+  gui_settle();
+
+  for(uint32_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+  {
+      memcpy(before, host_display_panel(), sizeof(before));
+      pixels  = stats_glyph_pixels();
+      rows    = host_display_counters.rows;
+
+      set_role(steps[i].role);
+      gui_settle();
+
+      memcpy(after, host_display_panel(), sizeof(after));
+      pixels  = stats_glyph_pixels() - pixels;
+      rows    = host_display_counters.rows - rows;
+
+      diff_cells(before, after, steps[i].first, steps[i].last, &inside, &outside);
+
+      // the old code blanked and redrew the whole line
+      printf("role %-8s glyph pixels %3u  changed %3u  rows %u  full line %u\n",
+             steps[i].role, pixels, inside + outside, rows, ROLE_TEXT_LEN * ROLE_CELL_W * ROLE_CELL_H);
+
+      CHECK(inside > 0);
+      CHECK_EQ(outside, 0);
+      // only the glyphs of the changed cells were blitted, each pixel once
+      CHECK_EQ(pixels, black_changed_cells(before, after, steps[i].first, steps[i].last));
+      CHECK(pixels <= (((steps[i].last - steps[i].first) + 1) * ROLE_CELL_W * ROLE_CELL_H));
+      CHECK_EQ(rows, ROLE_CELL_H);
+  }
+
+  // the same value again changes nothing and sends nothing
+  pixels  = stats_glyph_pixels();
+  rows    = host_display_counters.rows;
+  set_role("leader");
+  gui_settle();
+  CHECK_EQ(stats_glyph_pixels(), pixels);
+  CHECK_EQ(host_display_counters.rows, rows);
+
+  // same line as a fresh GUI that only ever showed the last value
+  memcpy(before, host_display_panel(), sizeof(before));
+
+  host_display_reset(HOST_DISPLAY_FRAMEBUFFERS);
+  CHECK_EQ(gui_init(), SL_STATUS_OK);
+  set_role("leader");
+  gui_settle();
+
+  CHECK_EQ(memcmp(&before[ROLE_Y * HOST_DISPLAY_ROW_BYTES],
+                  &host_display_panel()[ROLE_Y * HOST_DISPLAY_ROW_BYTES],
+                  ROLE_CELL_H * HOST_DISPLAY_ROW_BYTES), 0);
+}
+
+// a burst of state events over several passes without a frame tick goes out
+// as one flush, button feedback doesn't wait for the tick
+static void test_frame_cap(void)
+{
+  gui_event_t event = { .flag = GUI_EVENT_FLAG_NTWK_CH };
+  uint32_t    flushes = 0;
+
+  gui_settle();
+  gui_frame_tick();
+
+  for(uint32_t pass = 0; pass < 10; pass++)
+  {
+      event.channel = (uint8_t) (11 + pass);
+      queue_event(&event);
+      flushes += gui_update();
+  }
+
+  CHECK_EQ(flushes, 1);
+  CHECK(gui_display_is_dirty());
+
+  gui_button_handler(0, true);
+  CHECK(gui_update());
+
+  gui_settle();
+  gui_button_handler(0, false);
+  gui_settle();
+}
+
+// the state events of an attach, one per STORM_EVENT_MS, flushed at the
+// frame interval against a flush per event
+#define STORM_EVENT_MS  5
+#define STORM_EVENTS    200
+#define STORM_ROW_US    131   // one row at the 1.1 MHz SPI clock of the panel
+
+static void attach_storm(bool capped, uint32_t* flushes, uint32_t* rows)
+{
+  static const char* const roles[] = { "detached", "child", "router", "leader" };
+  gui_event_t              event;
+
+  gui_settle();
+
+  *flushes  = 0;
+  *rows     = host_display_counters.rows;
+
+  for(uint32_t i = 0; i < STORM_EVENTS; i++)
+  {
+      if(i & 1)
+      {
+          event.flag    = GUI_EVENT_FLAG_NTWK_CH;
+          event.channel = (uint8_t) (11 + ((i / 2) % 16));
+      }
+      else
+      {
+          event.flag    = GUI_EVENT_FLAG_NTWK_ROLE;
+          event.text    = roles[(i / 2) % 4];
+      }
+      queue_event(&event);
+
+      // the sleeptimer of the caller, or a tick before every update
+      if(!capped || (((i * STORM_EVENT_MS) % GUI_FRAME_INTERVAL_MS) == 0))
+      {
+          gui_frame_tick();
+      }
+
+      *flushes += gui_update();
+  }
+
+  gui_settle();
+
+  *rows = host_display_counters.rows - *rows;
+}
+
+static void test_attach_storm(void)
+{
+  const double  seconds = (STORM_EVENTS * STORM_EVENT_MS) / 1000.0;
+  uint32_t      capped_flushes, capped_rows, event_flushes, event_rows;
+
+  attach_storm(false, &event_flushes, &event_rows);
+  attach_storm(true, &capped_flushes, &capped_rows);
+
+  printf("attach storm       flushes/s capped %5.1f  per event %5.1f  rows %4u / %4u  saved %u us\n",
+         capped_flushes / seconds, event_flushes / seconds, capped_rows, event_rows,
+         (event_rows - capped_rows) * STORM_ROW_US);
+
+  CHECK(capped_flushes <= (((STORM_EVENTS * STORM_EVENT_MS) / GUI_FRAME_INTERVAL_MS) + 1));
+  CHECK(capped_rows < event_rows);
+}
+
+// gui_display_init reports what DMD did wrong and leaves nothing half set up
+static void test_init_errors(void)
+{
+  // DMD_init has no framebuffer to take
+  host_display_reset(0);
+  CHECK_EQ(gui_init(), SL_STATUS_INITIALIZATION);
+  CHECK(gui_display_get_framebuffer() == NULL);
+
+  // DMD_init took the only one, none left for the GUI
+  host_display_reset(1);
+  CHECK_EQ(gui_init(), SL_STATUS_ALLOCATION_FAILED);
+  CHECK(gui_display_get_framebuffer() == NULL);
+
+  // without a display events are still taken and nothing is sent
+  gui_button_handler(0, true);
+  gui_frame_tick();
+  CHECK(!gui_update());
+  CHECK_EQ(host_display_counters.transfers, 0);
+
+  host_display_reset(HOST_DISPLAY_FRAMEBUFFERS);
+  CHECK_EQ(gui_init(), SL_STATUS_OK);
+  CHECK_EQ(gui_display_get_row_stride(), HOST_DISPLAY_ROW_BYTES);
+}
+
+static uint32_t stats_bytes(void)
+{
+  gui_display_stats_t stats;
+
+  CHECK_EQ(gui_display_get_stats(&stats), SL_STATUS_OK);
+
+  return stats.bytes;
+}
+
+// bytes on the bus for a button press against the full frame flush every
+// update used to send, and the gui_display_stats_t count against the bus
+static void test_flush_bytes(void)
+{
+  const uint32_t  full_frame  = 2 + (HOST_DISPLAY_HEIGHT * (HOST_DISPLAY_ROW_BYTES + 2));
+  uint32_t        bytes, stats, transfers;
+  uint8_t         pressed[HOST_DISPLAY_BYTES];
+
+  bytes     = host_display_counters.bytes;
+  transfers = host_display_counters.transfers;
+  stats     = stats_bytes();
+
+  gui_button_handler(1, true);
+  gui_settle();
+
+  bytes     = host_display_counters.bytes - bytes;
+  transfers = host_display_counters.transfers - transfers;
+  stats     = stats_bytes() - stats;
+
+  printf("button press       bytes %5u  full frame %5u\n", bytes, full_frame);
+
+  // the press only touches the rows of the button
+  CHECK(bytes > 0);
+  CHECK(bytes <= (2 + (14 * (HOST_DISPLAY_ROW_BYTES + 2))));
+  CHECK(bytes < (full_frame / 8));
+
+  // the stats count rows, the bus also has a trailing byte per transfer
+  CHECK_EQ(bytes, stats + (2 * transfers));
+
+  memcpy(pressed, host_display_panel(), sizeof(pressed));
+
+  gui_button_handler(1, false);
+  gui_settle();
+
+  // a failed transfer leaves its rows pending, the next pass sends them
+  bytes = host_display_counters.bytes;
+  host_display_fail_draws(1);
+
+  gui_button_handler(1, true);
+  gui_update();
+  CHECK_EQ(host_display_counters.bytes, bytes);
+  CHECK(gui_display_is_busy());
+
+  gui_settle();
+  CHECK_EQ(host_display_diff(host_display_panel(), pressed), 0);
+
+  gui_button_handler(1, false);
+  gui_settle();
+}
+
+int main(void)
+{
+  test_init_errors();
+  test_boot();
+  test_network_state();
+  test_log();
+  test_buttons();
+  test_button_under_log_flood();
+  test_flush_bytes();
+  test_text_field_diff();
+  test_frame_cap();
+  test_attach_storm();
+
+  CHECK_EQ(remote_port_critical_depth, 0);
+
+  return TEST_RESULT();
+}
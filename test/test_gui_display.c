@@ -0,0 +1,215 @@
+/***************************************************************************//**
+ * @file
+ * @brief GUI Display Raster Host Tests
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <string.h>
+
+#include "glib.h"
+#include "gui_display.h"
+#include "host_display.h"
+#include "raster_ref.h"
+#include "test_util.h"
+
+// every raster call against raster_ref_rect, bit exact over the whole
+// framebuffer so a kernel writing outside its rectangle is caught too. every
+// x_min/x_max pair is tried, including ones the panel clips
+#define X_FIRST   (-3)
+#define X_LAST    (GUI_DISPLAY_WIDTH + 2)
+
+static GLIB_Context_t glib_context;
+
+static uint8_t  pattern[HOST_DISPLAY_BYTES];
+static uint8_t  background[HOST_DISPLAY_BYTES];
+static uint8_t  expected[HOST_DISPLAY_BYTES];
+
+static void check_rect(raster_ref_op_t op, int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max)
+{
+  uint8_t* framebuffer = host_display_framebuffer();
+
+  memcpy(framebuffer, pattern, HOST_DISPLAY_BYTES);
+  memcpy(expected, pattern, HOST_DISPLAY_BYTES);
+
+  raster_ref_kernel(op, x_min, y_min, x_max, y_max);
+  raster_ref_rect(expected, background, op, x_min, y_min, x_max, y_max);
+
+  if(memcmp(framebuffer, expected, HOST_DISPLAY_BYTES) != 0)
+  {
+      fprintf(stderr, "op %d x %d..%d y %d..%d: %u pixels differ\n", op,
+              x_min, x_max, y_min, y_max, host_display_diff(framebuffer, expected));
+      test_failures++;
+  }
+}
+
+static void test_alignments(void)
+{
+  for(raster_ref_op_t op = RASTER_REF_RESTORE; op <= RASTER_REF_INVERT; op++)
+  {
+      for(int32_t x_min = X_FIRST; x_min <= X_LAST; x_min++)
+      {
+          for(int32_t x_max = x_min; x_max <= X_LAST; x_max++)
+          {
+              check_rect(op, x_min, 61, x_max, 63);
+          }
+      }
+  }
+}
+
+static void test_rows(void)
+{
+  static const int32_t rows[][2] = {
+      {  0,   0 },
+      {  0, 127 },
+      { -5,   2 },
+      {125, 140 },
+      { 31,  32 },
+      { 10,   9 },    // empty
+      {128, 130 },    // below the panel
+  };
+
+  for(raster_ref_op_t op = RASTER_REF_RESTORE; op <= RASTER_REF_INVERT; op++)
+  {
+      for(uint32_t i = 0; i < sizeof(rows) / sizeof(rows[0]); i++)
+      {
+          check_rect(op, 5, rows[i][0], 100, rows[i][1]);
+          check_rect(op, 0, rows[i][0], 127, rows[i][1]);
+      }
+  }
+}
+
+static void render_glyph(char c, int32_t x, int32_t y)
+{
+  GLIB_drawChar(&glib_context, c, x, y, false);
+}
+
+// every glyph blitted against GLIB_drawChar at every x offset within and
+// across the word boundaries, and clipped at every panel edge. the blit counts
+// the pixels GLIB writes
+static void test_glyphs(void)
+{
+  static const int32_t  ys[] = { -7, -3, 0, 61, 120, 124, 127 };
+  uint8_t*              framebuffer = host_display_framebuffer();
+  gui_display_color_t   color;
+  gui_display_stats_t   stats;
+  uint32_t              glib_pixels;
+  uint32_t              glyph_pixels;
+
+  for(uint32_t c = GUI_DISPLAY_GLYPH_FIRST; c <= GUI_DISPLAY_GLYPH_LAST; c++)
+  {
+      for(int32_t x = -8; x <= (GUI_DISPLAY_WIDTH + 1); x++)
+      {
+          for(uint32_t i = 0; i < sizeof(ys) / sizeof(ys[0]); i++)
+          {
+              for(color = GUI_DISPLAY_BLACK; color <= GUI_DISPLAY_WHITE; color++)
+              {
+                  memcpy(framebuffer, pattern, HOST_DISPLAY_BYTES);
+                  glib_context.foregroundColor = (color == GUI_DISPLAY_WHITE) ? White : Black;
+                  glib_pixels = host_display_counters.pixels;
+                  GLIB_drawChar(&glib_context, (char) c, x, ys[i], false);
+                  glib_pixels = host_display_counters.pixels - glib_pixels;
+                  memcpy(expected, framebuffer, HOST_DISPLAY_BYTES);
+
+                  memcpy(framebuffer, pattern, HOST_DISPLAY_BYTES);
+                  CHECK_EQ(gui_display_get_stats(&stats), SL_STATUS_OK);
+                  glyph_pixels = stats.glyph_pixels;
+                  CHECK_EQ(gui_display_draw_glyph((char) c, x, ys[i], color), SL_STATUS_OK);
+                  CHECK_EQ(gui_display_get_stats(&stats), SL_STATUS_OK);
+                  CHECK_EQ(stats.glyph_pixels - glyph_pixels, glib_pixels);
+
+                  if(memcmp(framebuffer, expected, HOST_DISPLAY_BYTES) != 0)
+                  {
+                      fprintf(stderr, "glyph 0x%02x x %d y %d color %d: %u pixels differ\n", c, x, ys[i],
+                              color, host_display_diff(framebuffer, expected));
+                      test_failures++;
+                  }
+              }
+          }
+      }
+  }
+
+  glib_context.foregroundColor = Black;
+
+  // outside the captured range the caller falls back to GLIB
+  CHECK_EQ(gui_display_draw_glyph('\n', 0, 0, GUI_DISPLAY_BLACK), SL_STATUS_INVALID_PARAMETER);
+  CHECK_EQ(gui_display_draw_glyph((char) 0x80, 0, 0, GUI_DISPLAY_BLACK), SL_STATUS_INVALID_PARAMETER);
+  CHECK_EQ(gui_display_capture_font(9, 8, render_glyph), SL_STATUS_INVALID_PARAMETER);
+}
+
+// the dirty rows are exactly the rows the rectangle covers
+static void test_dirty(void)
+{
+  uint32_t rows;
+
+  // drain what init marked
+  CHECK_EQ(gui_display_flush_start(NULL), SL_STATUS_OK);
+  while(gui_display_is_busy())
+  {
+      gui_display_process();
+  }
+  CHECK(!gui_display_is_dirty());
+
+  gui_display_fill_rect(7, 40, 9, 44, GUI_DISPLAY_WHITE);
+  CHECK(gui_display_is_dirty());
+
+  rows = host_display_counters.rows;
+  CHECK_EQ(gui_display_flush_start(NULL), SL_STATUS_OK);
+  gui_display_process();
+  CHECK(!gui_display_is_busy());
+
+  CHECK_EQ(host_display_counters.rows - rows, 5);
+}
+
+int main(void)
+{
+  host_display_reset(HOST_DISPLAY_FRAMEBUFFERS);
+  CHECK_EQ(gui_display_init(), SL_STATUS_OK);
+
+  GLIB_contextInit(&glib_context);
+  CHECK_EQ(gui_display_draw_glyph('A', 0, 0, GUI_DISPLAY_BLACK), SL_STATUS_NOT_INITIALIZED);
+  CHECK_EQ(gui_display_capture_font(glib_context.font.fontWidth, glib_context.font.fontHeight, render_glyph),
+           SL_STATUS_OK);
+
+  // a background and a framebuffer that differ in every word
+  raster_ref_pattern(background, 1);
+  raster_ref_pattern(pattern, 2);
+
+  memcpy(host_display_framebuffer(), background, HOST_DISPLAY_BYTES);
+  CHECK_EQ(gui_display_capture_background(), SL_STATUS_OK);
+
+  test_alignments();
+  test_rows();
+  test_glyphs();
+  test_dirty();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,215 @@
+/***************************************************************************//**
+ * @file
+ * @brief GUI Event Queue Tests
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <string.h>
+
+#include "gui_event_queue.h"
+#include "remote_port.h"
+#include "test_util.h"
+
+// EVENT_QUEUE_INPUT_BUFFER_SIZE in gui_event_queue.c
+#define INPUT_SLOTS   8
+
+static void add(uint32_t flag, sl_status_t expected)
+{
+  gui_event_t event = { .flag = flag };
+
+  CHECK_EQ(gui_event_queue_add(&event), expected);
+}
+
+static gui_event_queue_stats_t stats(gui_event_lane_t lane)
+{
+  gui_event_queue_stats_t stats;
+
+  CHECK_EQ(gui_event_queue_get_stats(lane, &stats), SL_STATUS_OK);
+
+  return stats;
+}
+
+// drain the input lane into flags, returns the number of events
+static uint32_t drain(uint32_t* flags)
+{
+  gui_event_t event;
+  uint32_t    count = 0;
+
+  while(gui_event_queue_get(GUI_EVENT_LANE_INPUT, &event) == SL_STATUS_OK)
+  {
+      flags[count++] = event.flag;
+  }
+
+  return count;
+}
+
+// the input lane filled with alternating BTN0 presses and releases
+static void fill_input(gui_event_queue_policy_t policy)
+{
+  CHECK_EQ(gui_event_queue_init(), SL_STATUS_OK);
+  CHECK_EQ(gui_event_queue_set_policy(GUI_EVENT_LANE_INPUT, policy), SL_STATUS_OK);
+
+  for(uint32_t i = 0; i < INPUT_SLOTS; i++)
+  {
+      add((i & 1) ? GUI_EVENT_FLAG_BTN0_RELEASED : GUI_EVENT_FLAG_BTN0_PRESSED, SL_STATUS_OK);
+  }
+}
+
+static void test_reject(void)
+{
+  uint32_t flags[INPUT_SLOTS + 1];
+
+  fill_input(GUI_EVENT_QUEUE_POLICY_REJECT);
+
+  add(GUI_EVENT_FLAG_BTN1_PRESSED, SL_STATUS_FULL);
+
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).dropped, 1);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).enqueued, INPUT_SLOTS);
+  CHECK_EQ(drain(flags), INPUT_SLOTS);
+  CHECK_EQ(flags[INPUT_SLOTS - 1], GUI_EVENT_FLAG_BTN0_RELEASED);
+}
+
+static void test_overwrite_oldest(void)
+{
+  uint32_t flags[INPUT_SLOTS + 1];
+
+  fill_input(GUI_EVENT_QUEUE_POLICY_OVERWRITE_OLDEST);
+
+  add(GUI_EVENT_FLAG_BTN1_PRESSED, SL_STATUS_OK);
+
+  // the oldest may be getting rendered, the one after it goes
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).dropped, 1);
+  CHECK_EQ(drain(flags), INPUT_SLOTS);
+  CHECK_EQ(flags[0], GUI_EVENT_FLAG_BTN0_PRESSED);
+  CHECK_EQ(flags[1], GUI_EVENT_FLAG_BTN0_PRESSED);
+  CHECK_EQ(flags[INPUT_SLOTS - 1], GUI_EVENT_FLAG_BTN1_PRESSED);
+}
+
+// a full lane takes a release and the button doesn't stay drawn pressed
+static void test_coalesce(void)
+{
+  uint32_t flags[INPUT_SLOTS + 1];
+  uint32_t count;
+
+  fill_input(GUI_EVENT_QUEUE_POLICY_COALESCE);
+
+  // no other BTN1 event queued, the oldest but one goes
+  add(GUI_EVENT_FLAG_BTN1_PRESSED, SL_STATUS_OK);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).dropped, 1);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).coalesced, 0);
+
+  // the BTN1 press is superseded
+  add(GUI_EVENT_FLAG_BTN1_RELEASED, SL_STATUS_OK);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).dropped, 1);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).coalesced, 1);
+
+  // the oldest BTN0 event after the one being rendered is superseded
+  add(GUI_EVENT_FLAG_BTN0_PRESSED, SL_STATUS_OK);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).coalesced, 2);
+
+  count = drain(flags);
+  CHECK_EQ(count, INPUT_SLOTS);
+  CHECK_EQ(flags[0], GUI_EVENT_FLAG_BTN0_PRESSED);
+  CHECK_EQ(flags[count - 2], GUI_EVENT_FLAG_BTN1_RELEASED);
+  CHECK_EQ(flags[count - 1], GUI_EVENT_FLAG_BTN0_PRESSED);
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+      CHECK(flags[i] != GUI_EVENT_FLAG_BTN1_PRESSED);
+  }
+
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).enqueued, INPUT_SLOTS + 3);
+}
+
+// the stats count what the lanes saw, the high watermark outlives the drain
+static void test_stats(void)
+{
+  gui_event_t event = { .flag = GUI_EVENT_FLAG_LOG };
+  uint32_t    flags[INPUT_SLOTS];
+
+  CHECK_EQ(gui_event_queue_init(), SL_STATUS_OK);
+  CHECK_EQ(gui_event_queue_set_policy(GUI_EVENT_LANE_STATE, GUI_EVENT_QUEUE_POLICY_REJECT),
+           SL_STATUS_INVALID_PARAMETER);
+  CHECK_EQ(gui_event_queue_set_policy(GUI_EVENT_LANE_INPUT, GUI_EVENT_QUEUE_POLICY_COALESCE + 1),
+           SL_STATUS_INVALID_PARAMETER);
+  CHECK_EQ(gui_event_queue_set_policy(GUI_EVENT_LANE_INPUT, GUI_EVENT_QUEUE_POLICY_COALESCE),
+           SL_STATUS_OK);
+
+  add(GUI_EVENT_FLAG_BTN0_PRESSED, SL_STATUS_OK);
+  add(GUI_EVENT_FLAG_BTN0_RELEASED, SL_STATUS_OK);
+  add(GUI_EVENT_FLAG_BTN1_PRESSED, SL_STATUS_OK);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).depth, 3);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).high_watermark, 3);
+
+  CHECK_EQ(drain(flags), 3);
+  add(GUI_EVENT_FLAG_BTN1_RELEASED, SL_STATUS_OK);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).depth, 1);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).high_watermark, 3);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).enqueued, 4);
+  CHECK_EQ(stats(GUI_EVENT_LANE_INPUT).dropped, 0);
+
+  // log lane overwrites its oldest lines by default
+  for(uint32_t i = 0; i < 20; i++)
+  {
+      event.log.arg = (uint16_t) i;
+      CHECK_EQ(gui_event_queue_add(&event), SL_STATUS_OK);
+  }
+
+  CHECK_EQ(stats(GUI_EVENT_LANE_LOG).enqueued, 20);
+  CHECK_EQ(stats(GUI_EVENT_LANE_LOG).dropped, 4);
+  CHECK_EQ(stats(GUI_EVENT_LANE_LOG).high_watermark, 16);
+  CHECK_EQ(stats(GUI_EVENT_LANE_LOG).depth, 16);
+
+  // the state lane holds one per field
+  event.flag = GUI_EVENT_FLAG_NTWK_CH;
+  CHECK_EQ(gui_event_queue_add(&event), SL_STATUS_OK);
+  CHECK_EQ(gui_event_queue_add(&event), SL_STATUS_OK);
+  CHECK_EQ(stats(GUI_EVENT_LANE_STATE).depth, 1);
+  CHECK_EQ(stats(GUI_EVENT_LANE_STATE).coalesced, 1);
+  CHECK_EQ(stats(GUI_EVENT_LANE_STATE).dropped, 0);
+
+  CHECK_EQ(gui_event_queue_get_stats(GUI_EVENT_LANE_COUNT, &(gui_event_queue_stats_t) {0}),
+           SL_STATUS_INVALID_PARAMETER);
+  CHECK_EQ(gui_event_queue_get_stats(GUI_EVENT_LANE_INPUT, NULL), SL_STATUS_NULL_POINTER);
+}
+
+int main(void)
+{
+  test_reject();
+  test_overwrite_oldest();
+  test_coalesce();
+  test_stats();
+
+  CHECK_EQ(remote_port_critical_depth, 0);
+
+  return TEST_RESULT();
+}
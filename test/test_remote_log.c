@@ -0,0 +1,326 @@
+/***************************************************************************//**
+ * @file
+ * @brief Remote Log Host Tests
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+
+#include "remote_log.h"
+#include "remote_port.h"
+#include "test_util.h"
+
+// frames written through _putchar are captured, decoded again here and also
+// saved for test_remote_log_decode.py, which runs the host decoder on them
+static uint8_t  output[8192];
+static uint32_t output_len;
+
+void _putchar(char character)
+{
+  if(output_len < sizeof(output))
+  {
+      output[output_len++] = (uint8_t) character;
+  }
+}
+
+static void output_text(const char* text)
+{
+  while(*text != '\0')
+  {
+      _putchar(*text++);
+  }
+}
+
+// COBS decode of a frame without its zero delimiters, -1 when malformed
+static int32_t cobs_decode(const uint8_t* in, uint32_t length, uint8_t* out)
+{
+  uint32_t  index       = 0;
+  uint32_t  out_length  = 0;
+  uint8_t   code;
+
+  while(index < length)
+  {
+      code = in[index];
+      if((code == 0) || ((index + code) > length))
+      {
+          return -1;
+      }
+
+      memcpy(&out[out_length], &in[index + 1], code - 1);
+      out_length += code - 1;
+      index      += code;
+
+      if((code < 0xff) && (index < length))
+      {
+          out[out_length++] = 0;
+      }
+  }
+
+  return (int32_t) out_length;
+}
+
+// decode a frame back into a record
+static bool frame_to_record(const uint8_t* frame, uint32_t length, remote_log_record_t* record)
+{
+  uint8_t   payload[REMOTE_LOG_FRAME_MAX];
+  int32_t   payload_len;
+  uint32_t  argc;
+
+  if((length < 3) || (frame[0] != 0) || (frame[length - 1] != 0) ||
+     (memchr(&frame[1], 0, length - 2) != NULL))
+  {
+      return false;
+  }
+
+  payload_len = cobs_decode(&frame[1], length - 2, payload);
+  if(payload_len < 4)
+  {
+      return false;
+  }
+
+  memset(record, 0, sizeof(*record));
+  record->level = payload[0];
+  record->id    = (uint16_t) (payload[1] | (payload[2] << 8));
+  argc          = payload[3];
+
+  if((argc > REMOTE_LOG_ARGS) || ((uint32_t) payload_len < (4 + (4 * argc))))
+  {
+      return false;
+  }
+
+  for(uint32_t i = 0; i < argc; i++)
+  {
+      memcpy(&record->args[i], &payload[4 + (4 * i)], 4);
+  }
+
+  record->text_len = (uint8_t) (payload_len - (4 + (4 * argc)));
+  memcpy(record->text, &payload[4 + (4 * argc)], record->text_len);
+
+  return record->text_len <= REMOTE_LOG_TEXT_LEN;
+}
+
+static void check_roundtrip(const remote_log_record_t* record)
+{
+  uint8_t             frame[REMOTE_LOG_FRAME_MAX];
+  uint32_t            length;
+  remote_log_record_t decoded;
+
+  length = remote_log_encode(record, frame);
+  CHECK(length <= REMOTE_LOG_FRAME_MAX);
+  CHECK(frame_to_record(frame, length, &decoded));
+
+  CHECK_EQ(decoded.id, record->id);
+  CHECK_EQ(decoded.level, record->level);
+  CHECK_EQ(decoded.text_len, record->text_len);
+  CHECK_EQ(memcmp(decoded.args, record->args, sizeof(decoded.args)), 0);
+  CHECK_EQ(memcmp(decoded.text, record->text, record->text_len), 0);
+}
+
+static void test_encode(void)
+{
+  remote_log_record_t record = { .id = REMOTE_LOG_COAP_NON_ACK, .level = REMOTE_LOG_LEVEL_DEBUG };
+
+  // zero bytes everywhere in the arguments
+  for(uint32_t shift = 0; shift < 32; shift += 8)
+  {
+      record.args[0] = 1u << shift;
+      record.args[1] = ~(0xffu << shift);
+      record.args[2] = 0;
+      check_roundtrip(&record);
+  }
+
+  // trailing zero arguments are left out
+  record.args[0] = 0;
+  record.args[1] = 7;
+  check_roundtrip(&record);
+
+  // the largest record, one COBS block
+  memset(record.args, 0, sizeof(record.args));
+  memset(record.text, 'x', sizeof(record.text));
+  record.args[0]  = 0xffffffff;
+  record.args[1]  = 0x00ff00ff;
+  record.args[2]  = 0x80000000;
+  record.text_len = REMOTE_LOG_TEXT_LEN;
+  check_roundtrip(&record);
+
+  // id above 255
+  record.id = 0x1234;
+  check_roundtrip(&record);
+}
+
+// split the output back into frames
+static uint32_t output_records(remote_log_record_t* records, uint32_t max)
+{
+  uint32_t count = 0;
+  uint32_t start = 0;
+
+  for(uint32_t i = 1; (i < output_len) && (count < max); i++)
+  {
+      if(output[i] != 0)
+      {
+          continue;
+      }
+
+      if(output[start] == 0 && (i - start) > 1)
+      {
+          CHECK(frame_to_record(&output[start], (i - start) + 1, &records[count]));
+          count++;
+          start = i + 1;
+      }
+      else
+      {
+          start = i;
+      }
+  }
+
+  return count;
+}
+
+static void test_process(void)
+{
+  remote_log_record_t records[REMOTE_LOG_RING_LEN + 1];
+  uint32_t            count;
+
+  output_len = 0;
+
+  // text is copied and cut, the caller's buffer may go away
+  {
+      char name[] = "OpenThread-1c2d-and-more";
+
+      REMOTE_LOG_INFO_TEXT(REMOTE_LOG_NETWORK_NAME_CHANGED, name);
+      memset(name, 0, sizeof(name));
+  }
+  REMOTE_LOG_INFO(REMOTE_LOG_COAP_TX, 20, 0xfc00);
+  REMOTE_LOG_ERROR(REMOTE_LOG_COAP_SEND, 3);
+
+  remote_log_process();
+
+  count = output_records(records, 3);
+  CHECK_EQ(count, 3);
+  CHECK_EQ(records[0].id, REMOTE_LOG_NETWORK_NAME_CHANGED);
+  CHECK_EQ(records[0].level, REMOTE_LOG_LEVEL_INFO);
+  CHECK_EQ(records[0].text_len, REMOTE_LOG_TEXT_LEN);
+  CHECK_EQ(memcmp(records[0].text, "OpenThread-1c2d-", REMOTE_LOG_TEXT_LEN), 0);
+  CHECK_EQ(records[1].args[0], 20);
+  CHECK_EQ(records[1].args[1], 0xfc00);
+  CHECK_EQ(records[2].level, REMOTE_LOG_LEVEL_ERROR);
+  CHECK_EQ(records[2].args[0], 3);
+
+  // a burst larger than the ring, the rest is counted and reported first
+  output_len = 0;
+
+  for(uint32_t i = 0; i < REMOTE_LOG_RING_LEN + 5; i++)
+  {
+      REMOTE_LOG_INFO(REMOTE_LOG_STUB_DUPLICATE, i);
+  }
+  CHECK_EQ(remote_log_get_dropped(), 5);
+
+  // REMOTE_LOG_RECORDS_PER_PROCESS at a time, the loop stays awake for the rest
+  CHECK(remote_log_is_pending());
+  remote_log_process();
+  CHECK_EQ(output_records(records, REMOTE_LOG_RING_LEN + 1), REMOTE_LOG_RECORDS_PER_PROCESS + 1);
+  CHECK(remote_log_is_pending());
+
+  for(uint32_t i = 0; i < REMOTE_LOG_RING_LEN; i++)
+  {
+      remote_log_process();
+  }
+  CHECK(!remote_log_is_pending());
+
+  count = output_records(records, REMOTE_LOG_RING_LEN + 1);
+  CHECK_EQ(count, REMOTE_LOG_RING_LEN + 1);
+  CHECK_EQ(records[0].id, REMOTE_LOG_DROPPED);
+  CHECK_EQ(records[0].args[0], 5);
+
+  for(uint32_t i = 0; i < REMOTE_LOG_RING_LEN; i++)
+  {
+      CHECK_EQ(records[i + 1].args[0], i);
+  }
+
+  CHECK_EQ(remote_port_critical_depth, 0);
+}
+
+// the capture test_remote_log_decode.py expects, keep both in sync
+static void write_capture(const char* path)
+{
+  FILE* file;
+
+  output_len = 0;
+
+  REMOTE_LOG_INFO(REMOTE_LOG_HELLO);
+  remote_log_process();
+
+  output_text("plain printf output\r\n");
+
+  REMOTE_LOG_INFO(REMOTE_LOG_ERASE_PERSISTENT_INFO, 0);
+  REMOTE_LOG_INFO(REMOTE_LOG_JOINER_CALLBACK, 23);
+  REMOTE_LOG_INFO(REMOTE_LOG_ROLE_CHANGED, 4);
+  REMOTE_LOG_INFO_TEXT(REMOTE_LOG_NETWORK_NAME_CHANGED, "OpenThread-1c2d");
+  REMOTE_LOG_INFO(REMOTE_LOG_COAP_TX, 20, 0xfc00);
+  REMOTE_LOG_DEBUG(REMOTE_LOG_COAP_NON_ACK, 65536, 0x00ff00ff);
+  REMOTE_LOG_INFO(REMOTE_LOG_STUB_CLICK, 7, 'A');
+  REMOTE_LOG_ERROR(REMOTE_LOG_GUI_INIT, 0x19);
+
+  while(output_len < sizeof(output))
+  {
+      uint32_t before = output_len;
+
+      remote_log_process();
+      if(output_len == before)
+      {
+          break;
+      }
+  }
+
+  file = fopen(path, "wb");
+  CHECK(file != NULL);
+
+  if(file != NULL)
+  {
+      CHECK_EQ(fwrite(output, 1, output_len, file), output_len);
+      fclose(file);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  test_encode();
+  test_process();
+
+  if(argc > 1)
+  {
+      write_capture(argv[1]);
+  }
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+# Runs tools/remote_log_decode.py on the capture test_remote_log writes and
+# compares the text, keep EXPECTED in sync with write_capture there.
+
+import io
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'tools'))
+
+import remote_log_decode  # noqa: E402
+
+EXPECTED = (
+    'Hello from the remote app_init\r\n'
+    'plain printf output\r\n'
+    'erase persistent info: OK\r\n'
+    'joiner_callback event: NotFound\r\n'
+    'Thread Device Role Changed: leader\r\n'
+    'network name changed: OpenThread-1c2d\r\n'
+    'sending 20 bytes to rloc16 0xfc00\r\n'
+    'coap ack: 65536, 0x00ff00ff\r\n'
+    '[stub] click 7 \'A\'\r\n'
+    '[gui] init failed: 0x0019\r\n'
+)
+
+
+def main():
+    formats = remote_log_decode.load_messages(remote_log_decode.MESSAGES_H)
+    out = io.StringIO()
+
+    with open(sys.argv[1], 'rb') as capture:
+        remote_log_decode.decode(capture, formats, out)
+
+    if out.getvalue() != EXPECTED:
+        sys.stderr.write('decoded:\n%s\nexpected:\n%s\n' % (out.getvalue(), EXPECTED))
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,393 @@
+/***************************************************************************//**
+ * @file
+ * @brief Ring Buffer Host Tests
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ring_buffer.h"
+#include "test_util.h"
+
+#define STRESS_ENTRIES    64
+#define STRESS_COUNT      2000000u
+
+// several words per entry so a slot read before the producer's stores are
+// visible shows up as a torn entry
+typedef struct {
+  uint32_t  seq;
+  uint32_t  check;
+  uint32_t  fill[6];
+} stress_entry_t;
+
+typedef enum {
+  STRESS_COPY,        // add / get
+  STRESS_ZERO_COPY,   // reserve, commit / peek, release
+} stress_mode_t;
+
+typedef struct {
+  ring_buffer_handle_t* ring;
+  stress_mode_t         mode;
+  uint32_t              errors;
+} stress_t;
+
+static stress_entry_t       stress_buffer[STRESS_ENTRIES];
+static ring_buffer_handle_t stress_ring = {
+    .buffer   = stress_buffer,
+    .size     = sizeof(stress_entry_t),
+    .capacity = STRESS_ENTRIES,
+};
+
+static void stress_fill(stress_entry_t* entry, uint32_t seq)
+{
+  entry->seq    = seq;
+  entry->check  = seq * 2654435761u;
+
+  for(uint32_t i = 0; i < 6; i++)
+  {
+      entry->fill[i] = seq ^ i;
+  }
+}
+
+static bool stress_valid(const stress_entry_t* entry, uint32_t seq)
+{
+  if((entry->seq != seq) || (entry->check != seq * 2654435761u))
+  {
+      return false;
+  }
+
+  for(uint32_t i = 0; i < 6; i++)
+  {
+      if(entry->fill[i] != (seq ^ i))
+      {
+          return false;
+      }
+  }
+
+  return true;
+}
+
+static void* stress_producer(void* arg)
+{
+  stress_t*       stress = arg;
+  stress_entry_t  entry;
+  void*           slot;
+
+  for(uint32_t seq = 0; seq < STRESS_COUNT; seq++)
+  {
+      if(stress->mode == STRESS_COPY)
+      {
+          stress_fill(&entry, seq);
+
+          while(ring_buffer_add(stress->ring, &entry) == SL_STATUS_FULL)
+          {
+              sched_yield();
+          }
+      }
+      else
+      {
+          while(ring_buffer_reserve(stress->ring, &slot) == SL_STATUS_FULL)
+          {
+              sched_yield();
+          }
+
+          stress_fill(slot, seq);
+
+          if(ring_buffer_commit(stress->ring) != SL_STATUS_OK)
+          {
+              stress->errors++;
+          }
+      }
+  }
+
+  return NULL;
+}
+
+static void* stress_consumer(void* arg)
+{
+  stress_t*       stress = arg;
+  stress_entry_t  entry;
+  void*           slot;
+
+  for(uint32_t seq = 0; seq < STRESS_COUNT; seq++)
+  {
+      if(stress->mode == STRESS_COPY)
+      {
+          while(ring_buffer_get(stress->ring, &entry) == SL_STATUS_EMPTY)
+          {
+              sched_yield();
+          }
+
+          slot = &entry;
+      }
+      else
+      {
+          while(ring_buffer_peek(stress->ring, &slot) == SL_STATUS_EMPTY)
+          {
+              sched_yield();
+          }
+      }
+
+      // entries arrive once, in order and complete
+      if(!stress_valid(slot, seq))
+      {
+          stress->errors++;
+      }
+
+      if((stress->mode == STRESS_ZERO_COPY) && (ring_buffer_release(stress->ring) != SL_STATUS_OK))
+      {
+          stress->errors++;
+      }
+  }
+
+  return NULL;
+}
+
+static void test_stress(stress_mode_t mode)
+{
+  pthread_t producer, consumer;
+  stress_t  stress = { .ring = &stress_ring, .mode = mode };
+  uint64_t  start_ns;
+  double    seconds;
+
+  CHECK_EQ(ring_buffer_init(&stress_ring), SL_STATUS_OK);
+
+  start_ns = test_now_ns();
+
+  pthread_create(&consumer, NULL, stress_consumer, &stress);
+  pthread_create(&producer, NULL, stress_producer, &stress);
+
+  pthread_join(producer, NULL);
+  pthread_join(consumer, NULL);
+
+  seconds = (double) (test_now_ns() - start_ns) / 1e9;
+
+  printf("%-9s %u entries in %.3f s, %.2f M entries/s\n",
+         (mode == STRESS_COPY) ? "copy" : "zero copy",
+         STRESS_COUNT, seconds, (double) STRESS_COUNT / seconds / 1e6);
+
+  CHECK_EQ(stress.errors, 0);
+  CHECK_EQ(ring_buffer_count(&stress_ring), 0);
+}
+
+static void test_init(void)
+{
+  uint32_t              storage[3];
+  ring_buffer_handle_t  odd = {
+      .buffer   = storage,
+      .size     = sizeof(uint32_t),
+      .capacity = 3,
+  };
+
+  CHECK_EQ(ring_buffer_init(NULL), SL_STATUS_NULL_POINTER);
+  CHECK_EQ(ring_buffer_init(&odd), SL_STATUS_INVALID_PARAMETER);
+}
+
+static void test_full_empty(void)
+{
+  stress_entry_t  entry;
+  void*           slot;
+
+  CHECK_EQ(ring_buffer_init(&stress_ring), SL_STATUS_OK);
+
+  CHECK_EQ(ring_buffer_get(&stress_ring, &entry), SL_STATUS_EMPTY);
+  CHECK_EQ(ring_buffer_peek(&stress_ring, &slot), SL_STATUS_EMPTY);
+  CHECK_EQ(ring_buffer_release(&stress_ring), SL_STATUS_EMPTY);
+
+  for(uint32_t seq = 0; seq < STRESS_ENTRIES; seq++)
+  {
+      stress_fill(&entry, seq);
+      CHECK_EQ(ring_buffer_add(&stress_ring, &entry), SL_STATUS_OK);
+  }
+
+  CHECK_EQ(ring_buffer_add(&stress_ring, &entry), SL_STATUS_FULL);
+  CHECK_EQ(ring_buffer_reserve(&stress_ring, &slot), SL_STATUS_FULL);
+  CHECK_EQ(ring_buffer_commit(&stress_ring), SL_STATUS_FULL);
+  CHECK_EQ(ring_buffer_count(&stress_ring), STRESS_ENTRIES);
+
+  CHECK_EQ(ring_buffer_get(&stress_ring, &entry), SL_STATUS_OK);
+  CHECK(stress_valid(&entry, 0));
+}
+
+// add_n/get_n from every start position, so every split of a batch into the
+// span up to the end of the buffer and the span from the start is covered
+static void test_batch_wrap(void)
+{
+  stress_entry_t  in[STRESS_ENTRIES];
+  stress_entry_t  out[STRESS_ENTRIES];
+  stress_entry_t  entry;
+
+  for(uint32_t start = 0; start < STRESS_ENTRIES; start++)
+  {
+      for(uint32_t count = 1; count <= STRESS_ENTRIES; count++)
+      {
+          CHECK_EQ(ring_buffer_init(&stress_ring), SL_STATUS_OK);
+
+          // move head and tail to start
+          for(uint32_t i = 0; i < start; i++)
+          {
+              stress_fill(&entry, i);
+              ring_buffer_add(&stress_ring, &entry);
+              ring_buffer_get(&stress_ring, &entry);
+          }
+
+          for(uint32_t i = 0; i < count; i++)
+          {
+              stress_fill(&in[i], start + i);
+          }
+
+          memset(out, 0, sizeof(out));
+
+          CHECK_EQ(ring_buffer_add_n(&stress_ring, in, count), count);
+          CHECK_EQ(ring_buffer_count(&stress_ring), count);
+
+          // read back in two uneven halves to cover a split on the way out too
+          CHECK_EQ(ring_buffer_get_n(&stress_ring, out, count / 2), count / 2);
+          CHECK_EQ(ring_buffer_get_n(&stress_ring, &out[count / 2], STRESS_ENTRIES), count - (count / 2));
+
+          for(uint32_t i = 0; i < count; i++)
+          {
+              CHECK(stress_valid(&out[i], start + i));
+          }
+
+          CHECK_EQ(ring_buffer_count(&stress_ring), 0);
+      }
+  }
+}
+
+// batches are clamped to the free space and to the queued entries
+static void test_batch_clamp(void)
+{
+  stress_entry_t  in[STRESS_ENTRIES];
+  stress_entry_t  out[STRESS_ENTRIES];
+
+  for(uint32_t i = 0; i < STRESS_ENTRIES; i++)
+  {
+      stress_fill(&in[i], i);
+  }
+
+  CHECK_EQ(ring_buffer_init(&stress_ring), SL_STATUS_OK);
+
+  CHECK_EQ(ring_buffer_add_n(&stress_ring, in, 10), 10);
+  CHECK_EQ(ring_buffer_add_n(&stress_ring, in, STRESS_ENTRIES), STRESS_ENTRIES - 10);
+  CHECK_EQ(ring_buffer_add_n(&stress_ring, in, 1), 0);
+
+  CHECK_EQ(ring_buffer_get_n(&stress_ring, out, 4), 4);
+  CHECK_EQ(ring_buffer_get_n(&stress_ring, out, STRESS_ENTRIES), STRESS_ENTRIES - 4);
+  CHECK_EQ(ring_buffer_get_n(&stress_ring, out, 1), 0);
+
+  CHECK_EQ(ring_buffer_add_n(NULL, in, 1), 0);
+  CHECK_EQ(ring_buffer_get_n(&stress_ring, NULL, 1), 0);
+}
+
+// entry/remove from every start position and offset, so the shift of the
+// newer entries runs across the end of the buffer
+static void test_remove_wrap(void)
+{
+  const uint32_t  count = 8;
+  stress_entry_t  entry;
+  void*           slot;
+
+  for(uint32_t start = STRESS_ENTRIES - count; start < STRESS_ENTRIES + 2; start++)
+  {
+      for(uint32_t offset = 0; offset <= count; offset++)
+      {
+          CHECK_EQ(ring_buffer_init(&stress_ring), SL_STATUS_OK);
+
+          // move head and tail to start
+          for(uint32_t i = 0; i < start; i++)
+          {
+              stress_fill(&entry, i);
+              ring_buffer_add(&stress_ring, &entry);
+              ring_buffer_get(&stress_ring, &entry);
+          }
+
+          for(uint32_t i = 0; i < count; i++)
+          {
+              stress_fill(&entry, i);
+              ring_buffer_add(&stress_ring, &entry);
+          }
+
+          for(uint32_t i = 0; i < count; i++)
+          {
+              CHECK_EQ(ring_buffer_entry(&stress_ring, i, &slot), SL_STATUS_OK);
+              CHECK(stress_valid(slot, i));
+          }
+          CHECK_EQ(ring_buffer_entry(&stress_ring, count, &slot), SL_STATUS_INVALID_PARAMETER);
+
+          // the oldest entry may be held by the consumer, out of range is refused
+          if((offset == 0) || (offset == count))
+          {
+              CHECK_EQ(ring_buffer_remove(&stress_ring, offset), SL_STATUS_INVALID_PARAMETER);
+              CHECK_EQ(ring_buffer_count(&stress_ring), count);
+              continue;
+          }
+
+          CHECK_EQ(ring_buffer_remove(&stress_ring, offset), SL_STATUS_OK);
+          CHECK_EQ(ring_buffer_count(&stress_ring), count - 1);
+
+          // the others in order, the freed slot is usable again
+          stress_fill(&entry, count);
+          CHECK_EQ(ring_buffer_add(&stress_ring, &entry), SL_STATUS_OK);
+
+          for(uint32_t i = 0; i <= count; i++)
+          {
+              if(i == offset)
+              {
+                  continue;
+              }
+
+              CHECK_EQ(ring_buffer_get(&stress_ring, &entry), SL_STATUS_OK);
+              CHECK(stress_valid(&entry, i));
+          }
+
+          CHECK_EQ(ring_buffer_count(&stress_ring), 0);
+      }
+  }
+}
+
+int main(void)
+{
+  test_init();
+  test_full_empty();
+  test_batch_wrap();
+  test_batch_clamp();
+  test_remove_wrap();
+  test_stress(STRESS_COPY);
+  test_stress(STRESS_ZERO_COPY);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,81 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host Test Helpers
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has not been formally tested and is provided as-is. It is not
+ * suitable for production environments. In addition, this code will not be
+ * maintained and there may be no bug maintenance planned for these resources.
+ * Silicon Labs may update projects from time to time.
+ ******************************************************************************/
+#ifndef TEST_UTIL_H_
+#define TEST_UTIL_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+// failed checks are reported and counted, the test keeps going so one run
+// shows every failure
+static int test_failures;
+
+#define CHECK(cond)                                                             \
+  do {                                                                          \
+    if(!(cond))                                                                 \
+    {                                                                           \
+        fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);\
+        test_failures++;                                                        \
+    }                                                                           \
+  } while(0)
+
+#define CHECK_EQ(a, b)                                                          \
+  do {                                                                          \
+    long long _a = (long long) (a);                                             \
+    long long _b = (long long) (b);                                             \
+    if(_a != _b)                                                                \
+    {                                                                           \
+        fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed, %lld != %lld\n",       \
+                __FILE__, __LINE__, #a, #b, _a, _b);                            \
+        test_failures++;                                                        \
+    }                                                                           \
+  } while(0)
+
+// exit code for main
+#define TEST_RESULT()   ((test_failures == 0) ? 0 : 1)
+
+// monotonic time for the benchmarks, in ns
+static inline uint64_t test_now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ((uint64_t) ts.tv_sec * 1000000000u) + (uint64_t) ts.tv_nsec;
+}
+
+#endif /* TEST_UTIL_H_ */
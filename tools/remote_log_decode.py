@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+# Decode the binary log frames of remote_log.c back into text.
+#
+#   remote_log_decode.py capture.bin
+#   cat /dev/ttyACM0 | remote_log_decode.py
+#
+# Message ids and formats are read from remote_log_messages.h, so the decoder
+# always matches the firmware built from the same tree. Bytes outside of a
+# frame (plain printf output on the same port) are passed through unchanged.
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MESSAGES_H = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'remote_log_messages.h')
+
+LEVELS = {1: 'E', 2: 'I', 3: 'D'}
+
+# otThreadErrorToString
+OT_ERRORS = [
+    'OK', 'Failed', 'Drop', 'NoBufs', 'NoRoute', 'Busy', 'Parse', 'InvalidArgs',
+    'Security', 'AddressQuery', 'NoAddress', 'Abort', 'NotImplemented',
+    'InvalidState', 'NoAck', 'ChannelAccessFailure', 'Detached', 'FcsErr',
+    'NoFrameReceived', 'UnknownNeighbor', 'InvalidSourceAddress',
+    'AddressFiltered', 'DestinationAddressFiltered', 'NotFound', 'Already',
+    'ReservedError25', 'Ip6AddressCreationFailure', 'NotCapable',
+    'ResponseTimeout', 'Duplicated', 'ReassemblyTimeout', 'NotTmf',
+    'NonLowpanDataFrame', 'ReservedError33', 'LinkMarginLow', 'InvalidCommand',
+    'Pending', 'Rejected',
+]
+
+# otThreadDeviceRoleToString
+OT_ROLES = ['disabled', 'detached', 'child', 'router', 'leader']
+
+SPEC = re.compile(r'%([-+ #0]*)(\d*)([udxXcsER%])')
+
+
+def load_messages(path):
+    """List of formats indexed by id, in the order of REMOTE_LOG_MESSAGES."""
+    formats = []
+    with open(path, encoding='utf-8') as header:
+        for match in re.finditer(r'^\s*X\((\w+),\s*("(?:[^"\\]|\\.)*")\)', header.read(), re.M):
+            formats.append((match.group(1), match.group(2)[1:-1].encode().decode('unicode_escape')))
+    return formats
+
+
+def cobs_decode(data):
+    out = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        if code == 0 or index + code > len(data):
+            return None
+        out += data[index + 1:index + code]
+        index += code
+        if code < 0xff and index < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def format_message(fmt, args, text):
+    args = list(args)
+
+    def arg():
+        return args.pop(0) if args else 0
+
+    def spec(match):
+        flags, width, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if conv == 's':
+            return ('%' + flags + width + 's') % text
+        value = arg()
+        if conv == 'E':
+            return OT_ERRORS[value] if value < len(OT_ERRORS) else str(value)
+        if conv == 'R':
+            return OT_ROLES[value] if value < len(OT_ROLES) else str(value)
+        if conv == 'd':
+            value = struct.unpack('<i', struct.pack('<I', value))[0]
+        if conv == 'u':
+            conv = 'd'
+        return ('%' + flags + width + conv) % value
+
+    return SPEC.sub(spec, fmt)
+
+
+def decode_frame(payload, formats):
+    """Text of a frame payload, None when it isn't a log record."""
+    if payload is None or len(payload) < 4:
+        return None
+    level, ident, argc = payload[0], payload[1] | (payload[2] << 8), payload[3]
+    if level not in LEVELS or ident >= len(formats) or argc > 3 or len(payload) < 4 + 4 * argc:
+        return None
+    args = struct.unpack_from('<%dI' % argc, payload, 4)
+    text = payload[4 + 4 * argc:].decode('utf-8', 'replace')
+    return format_message(formats[ident][1], args, text)
+
+
+def decode_chunk(chunk, formats, out, levels):
+    payload = cobs_decode(chunk)
+    text = decode_frame(payload, formats)
+    if text is None:
+        out.write(chunk.decode('utf-8', 'replace'))
+    elif levels:
+        out.write('%s: %s\r\n' % (LEVELS[payload[0]], text))
+    else:
+        out.write(text + '\r\n')
+
+
+def decode(stream, formats, out, levels=False):
+    # frames are wrapped in zeros, whatever sits between two frames is text.
+    # reads as bytes arrive so a live port can be piped in
+    pending = b''
+    while True:
+        data = stream.read1(4096) if hasattr(stream, 'read1') else stream.read(4096)
+        if not data:
+            break
+        chunks = (pending + data).split(b'\x00')
+        pending = chunks.pop()
+        for chunk in chunks:
+            if chunk:
+                decode_chunk(chunk, formats, out, levels)
+        out.flush()
+    if pending:
+        decode_chunk(pending, formats, out, levels)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='decode remote_log frames')
+    parser.add_argument('capture', nargs='?', help='captured bytes, stdin when omitted')
+    parser.add_argument('--messages', default=MESSAGES_H, help='remote_log_messages.h')
+    parser.add_argument('--levels', action='store_true', help='prefix lines with the log level')
+    args = parser.parse_args()
+
+    formats = load_messages(args.messages)
+
+    if args.capture:
+        with open(args.capture, 'rb') as capture:
+            decode(capture, formats, sys.stdout, args.levels)
+    else:
+        decode(sys.stdin.buffer, formats, sys.stdout, args.levels)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# Refresh the Simplicity Studio project export with the sources of this tree.
+#
+#   sls_export.py            rewrite SimplicityStudio/openclicker_remote.sls
+#   sls_export.py --check    exit 1 when the export is out of date
+#
+# The export is a zip of the Studio project. Every .c and .h file of the
+# repository root is copied into it and listed in the slcp, everything else
+# (main.c, app.h, config, autogen, project settings) is kept as it is.
+
+import argparse
+import os
+import sys
+import zipfile
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+EXPORT = os.path.join(ROOT, 'SimplicityStudio', 'openclicker_remote.sls')
+SLCP = 'openclicker_remote.slcp'
+
+# part of the Studio project only, not of the repository root
+PROJECT_SOURCES = ['main.c']
+PROJECT_HEADERS = ['app.h']
+
+
+def tree_sources():
+    return sorted(f for f in os.listdir(ROOT)
+                  if f.endswith(('.c', '.h')) and os.path.isfile(os.path.join(ROOT, f)))
+
+
+def replace_list(lines, start, prefix, paths):
+    end = start
+    while end < len(lines) and lines[end].startswith(prefix):
+        end += 1
+    lines[start:end] = ['%s%s}' % (prefix, path) for path in paths]
+
+
+# the source: and include: file_list: entries of the slcp, the rest untouched
+def update_slcp(text, sources):
+    lines = text.split('\n')
+
+    replace_list(lines, lines.index('source:') + 1, '- {path: ',
+                 PROJECT_SOURCES + [f for f in sources if f.endswith('.c')])
+    replace_list(lines, lines.index('  file_list:') + 1, '  - {path: ',
+                 PROJECT_HEADERS + [f for f in sources if f.endswith('.h')])
+
+    return '\n'.join(lines)
+
+
+# file name -> content of the export as it should be
+def expected_entries(export):
+    sources = tree_sources()
+    entries = {}
+
+    for info in export.infolist():
+        if info.filename not in sources:
+            entries[info.filename] = export.read(info)
+
+    entries[SLCP] = update_slcp(entries[SLCP].decode(), sources).encode()
+
+    for name in sources:
+        with open(os.path.join(ROOT, name), 'rb') as f:
+            entries[name] = f.read()
+
+    return entries
+
+
+def write(export, entries, path):
+    infos = {info.filename: info for info in export.infolist()}
+    stamp = infos[SLCP].date_time
+
+    with zipfile.ZipFile(path, 'w', zipfile.ZIP_DEFLATED) as out:
+        for name, data in entries.items():
+            info = zipfile.ZipInfo(name, infos[name].date_time if name in infos else stamp)
+            info.compress_type = zipfile.ZIP_DEFLATED
+            info.external_attr = infos[name].external_attr if name in infos else (0o644 << 16)
+            out.writestr(info, data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--check', action='store_true', help='only report an out of date export')
+    args = parser.parse_args()
+
+    with zipfile.ZipFile(EXPORT) as export:
+        entries = expected_entries(export)
+        stale = sorted(name for name, data in entries.items()
+                       if (name not in export.namelist()) or (export.read(name) != data))
+
+        if args.check:
+            for name in stale:
+                print('%s: out of date in the export, run tools/sls_export.py' % name)
+            return 1 if stale else 0
+
+        if stale:
+            write(export, entries, EXPORT + '.tmp')
+
+    if stale:
+        os.replace(EXPORT + '.tmp', EXPORT)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())